@@ -3,8 +3,16 @@
 #include "style/Size.h"
 #include "style/Layout.h"
 #include "style/Color.h"
+#include "style/Theme.h"
+#include "EventPolicy.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 struct _lv_obj_t;
 typedef _lv_obj_t lv_obj_t;
@@ -16,7 +24,181 @@ int _lvPreinit();
 int _lvInit();
 void _lvDeinit();
 void _lvLoop();
+/**
+ * @brief Run task on the UI thread during the next lv_timer_handler
+ * @note Safe to call from any thread, the tasks are queued without touching LVGL
+ */
 void _lvAsyncCall(std::function<void()> task);
+/**
+ * @brief Run task on the UI thread once the next display refresh is due
+ * @note UI thread only, unlike _lvAsyncCall the task does not run again in the same lv_timer_handler
+ */
+void _lvCallNextFrame(std::function<void()> task);
+
+// ==================== Headless display ====================
+enum class PixelFormat : uint8_t {
+    Native,     ///< lv_color_t of the LVGL build
+    Rgb565
+};
+
+struct DisplayConfig
+{
+    int32_t width = 480;
+    int32_t height = 272;
+    uint32_t bufferLines = 0;   ///< Lines of the partial draw buffer, 0 for a buffer as large as the screen
+    bool doubleBuffered = false;    ///< Render into one buffer while a worker thread flushes the other
+    PixelFormat format = PixelFormat::Native;   ///< Pixel format of the framebuffer, i.e. of the panel
+};
+
+struct FramebufferView
+{
+    const void* pixels = nullptr;
+    int32_t width = 0;
+    int32_t height = 0;
+    uint32_t stride = 0;        ///< Bytes per row
+    uint8_t bitsPerPixel = 0;   ///< LV_COLOR_DEPTH of the LVGL build
+};
+
+/**
+ * @brief Register a display that renders into a framebuffer in RAM, e.g. for tests and benchmarks
+ * @note Call after _lvInit, the display becomes the default one
+ */
+int _lvCreateHeadlessDisplay(const DisplayConfig& config);
+void _lvDestroyHeadlessDisplay();
+FramebufferView _lvGetFramebuffer();
+
+struct FlushStats
+{
+    uint32_t flushes = 0;
+    uint64_t pixels = 0;
+    uint64_t busyNs = 0;            ///< Time spent converting and copying
+    const char* conversion = "";    ///< Pixel conversion path in use
+
+    double megapixelsPerSecond() const { return busyNs ? double(pixels) * 1e3 / double(busyNs) : 0.0; }
+};
+
+struct ConversionBenchmark
+{
+    const char* path;
+    double megapixelsPerSecond;
+};
+
+FlushStats _lvGetFlushStats();
+void _lvResetFlushStats();
+
+/**
+ * @brief Measure every pixel conversion path the CPU supports on a synthetic frame
+ * @param[in] pixels Pixels per round
+ * @param[in] rounds Number of conversions per path
+ */
+std::vector<ConversionBenchmark> _lvBenchmarkPixelConversion(size_t pixels, uint32_t rounds);
+
+/**
+ * @brief Advance the LVGL clock by ms and run the due timers once
+ * @return Number of frames flushed completely during the step
+ */
+uint32_t _lvStep(uint32_t ms);
+
+// ==================== Build scope ====================
+struct BuildStats
+{
+    uint32_t builds = 0;
+    uint32_t lastObjects = 0;
+    uint64_t totalObjects = 0;
+    uint64_t lastBuildUs = 0;       ///< Outermost scope, creating the objects, applying modifiers and the layout
+    uint64_t lastLayoutUs = 0;      ///< Part of lastBuildUs spent in the layout pass
+    uint64_t totalBuildUs = 0;
+};
+
+/**
+ * @brief Suspend layout and invalidation of the subtree created until the matching _lvEndBuild
+ * @note Scopes nest, only the outermost one commits the layout
+ */
+void _lvBeginBuild();
+void _lvEndBuild();
+BuildStats _lvGetBuildStats();
+
+// ==================== Redraw profiler ====================
+struct RedrawStat
+{
+    std::string name;
+    uint64_t invalidations = 0;
+    uint64_t pixels = 0;
+    uint32_t frames = 0;    ///< Frames in which the view invalidated anything
+};
+
+struct RedrawReport
+{
+    uint32_t frames = 0;
+    uint64_t invalidatedPixels = 0;
+    uint64_t flushedPixels = 0;
+    std::vector<RedrawStat> top;    ///< Sorted by invalidated pixels, descending
+};
+
+/**
+ * @brief Attribute the invalidated areas of the default display to the view tagged with _lvSetRedrawTag
+ * @note Wraps the rounder and flush callbacks of the display driver while enabled
+ */
+void _lvEnableRedrawProfiler(bool isEnabled);
+
+/**
+ * @brief Name the view that causes the following invalidations
+ * @param[in] name View name, nullptr for LVGL itself (animations, scrolling, ...)
+ * @return Previous tag, to be restored when the scope ends
+ */
+const char* _lvSetRedrawTag(const char* name);
+RedrawReport _lvGetRedrawReport(size_t topN);
+void _lvResetRedrawProfiler();
+
+// ==================== Recording ====================
+// While a recording runs, every adaptor call that changes the UI is appended to a binary log with its time,
+// objects are referred to by ids assigned at creation. Replaying the log reproduces the session on this
+// backend, e.g. on the headless display for a performance regression test. Input is not part of the log:
+// callbacks are replaced by empty ones, the calls they made are in the log themselves, as are the values
+// chart and log view sources returned. All functions run on the UI thread.
+
+enum class ReplaySpeed : uint8_t {
+    Original,   ///< Wait for the recorded time of every call
+    Maximum     ///< Run the calls back to back, the LVGL clock still advances by the recorded time
+};
+
+struct RecordingStats
+{
+    uint64_t calls = 0;
+    uint64_t bytes = 0;         ///< Written to the file so far
+    uint32_t objects = 0;
+    bool failed = false;        ///< A write failed, the recording stopped there
+};
+
+struct ReplayStats
+{
+    uint64_t calls = 0;
+    uint32_t steps = 0;         ///< Timer cycles run, one per recorded _lvLoop cycle or _lvStep
+    uint32_t frames = 0;        ///< Frames flushed completely by the headless display
+    uint64_t recordedUs = 0;    ///< Duration of the session
+    uint64_t replayUs = 0;      ///< Duration of the replay
+};
+
+/**
+ * @brief Start logging the adaptor calls to path, replacing the file
+ * @return -1 if a recording runs already or the file cannot be created
+ */
+int _lvStartRecording(const char* path);
+void _lvStopRecording();
+
+/**
+ * @brief Stats of the running recording, or of the last one once it stopped
+ */
+RecordingStats _lvGetRecordingStats();
+
+/**
+ * @brief Run the calls of a recording on this backend
+ * @param[in] root Stands in for every object the session did not create through the adaptor, e.g. the screen
+ * @note Timer cycles run through _lvStep, so with the headless display and no tick callback the replay renders
+ *       the same frames every time, at either speed
+ * @return -1 if the file is not a recording or ends in the middle of a call, the calls before it have run
+ */
+int _lvReplay(const char* path, lv_obj_t* root, ReplaySpeed speed, ReplayStats* stats = nullptr);
 
 // Forward declarations for LVGL implementation functions
 lv_obj_t* _lvCreateObj(lv_obj_t* parent);
@@ -25,19 +207,389 @@ void _lvDestroyObj(lv_obj_t* obj);
 lv_obj_t* _lvCreateVStack(lv_obj_t* parent);
 lv_obj_t* _lvCreateHStack(lv_obj_t* parent);
 lv_obj_t* _lvCreateZStack(lv_obj_t* parent);
+lv_obj_t* _lvCreateStack(lv_obj_t* parent, const style::StackLayout& layout);
 
 void _lvSetFlexAlignment(lv_obj_t* obj, style::Layout::Horizontal align);
 void _lvSetFlexAlignment(lv_obj_t* obj, style::Layout::Vertical align);
 
+// ==================== Text measurement cache ====================
+struct TextCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t capacity = 0;
+
+    double hitRate() const
+    {
+        uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+/**
+ * @brief Size of text in the font and spacing of obj, memoised by font, text and width
+ * @param[in] maxWidth Width the text wraps at, LV_COORD_MAX for a single line
+ */
+style::Size _lvMeasureText(lv_obj_t* obj, const char* text, int maxWidth);
+TextCacheStats _lvGetTextCacheStats();
+void _lvResetTextCacheStats();
+
 lv_obj_t* _lvCreateLabel(lv_obj_t* parent);
 void _lvSetText(lv_obj_t* obj, const char* text);
+void _lvSetTextStatic(lv_obj_t* obj, const char* text);
 
 lv_obj_t* _lvCreateButton(lv_obj_t* parent);
 void _lvSetButtonText(lv_obj_t* obj, const char* text);
+void _lvSetButtonTextStatic(lv_obj_t* obj, const char* text);
 void _lvSetOnClick(lv_obj_t* obj, std::function<void()> callback);
 
+/**
+ * @brief Handle clicks bubbled up from any descendant with one callback on the container
+ * @param[in] callback Receives the direct child the click originated from, which may be an object the view did not
+ * create
+ */
+void _lvSetOnChildClick(lv_obj_t* obj, std::function<void(lv_obj_t*)> callback);
+void _lvSetEventBubble(lv_obj_t* obj, bool isEnabled);
+
+// ==================== List ====================
+// A list created for the List view holds item rows only, each row stores its index in its user data
+
+lv_obj_t* _lvCreateList(lv_obj_t* parent);
+
+/**
+ * @brief Append a section title, which is no item row and does not take an index
+ */
+void _lvAddListItem(lv_obj_t* obj, const char* text);
+
+/**
+ * @brief Append rows in one pass without redrawing the list per row
+ * @param[in] texts Row texts, copied by LVGL
+ * @param[in] count Number of rows
+ */
+void _lvAddListItems(lv_obj_t* obj, const char* const* texts, size_t count);
+void _lvRemoveListItem(lv_obj_t* obj, size_t index);
+void _lvClearListItems(lv_obj_t* obj);
+void _lvSetListOnItemSelected(lv_obj_t* obj, std::function<void(int, const std::string&)> callback);
+
+// ==================== Log view ====================
+// A scrollable object that creates labels for the visible rows only, lines are fetched from the source when
+// a row scrolls into view. All functions run on the UI thread.
+
+struct LogViewStats
+{
+    uint32_t rows = 0;              ///< Labels in the row pool
+    uint32_t updates = 0;
+    uint64_t rowsRefreshed = 0;     ///< Label texts set, i.e. rows that had to render a different line
+};
+
+lv_obj_t* _lvCreateLogView(lv_obj_t* parent);
+
+/**
+ * @brief Set where rows read their text from
+ * @param[in] line Returns line index (0 is the oldest line) as text, valid until the call returns
+ */
+void _lvSetLogViewSource(lv_obj_t* obj, std::function<const char*(size_t)> line);
+
+/**
+ * @brief Tell the view that lines were appended and dropped
+ * @param[in] count Number of lines now
+ * @param[in] dropped Lines removed from the front since the last update, the remaining lines move up by that
+ */
+void _lvUpdateLogView(lv_obj_t* obj, size_t count, size_t dropped);
+
+/**
+ * @brief Keep the newest line in view while the user has not scrolled away from the bottom
+ */
+void _lvSetLogViewAutoScroll(lv_obj_t* obj, bool isEnabled);
+LogViewStats _lvGetLogViewStats(lv_obj_t* obj);
+
+// ==================== Theme ====================
+// Every token is one shared style. An object adds the style of its token, a theme switch rewrites the styles
+// in place and reports each changed one to LVGL once, no object is visited by the adaptor. Local values
+// (e.g. _lvSetBgColor) take precedence over tokens. All functions run on the UI thread.
+
+struct ThemeSwitchBenchmark
+{
+    uint32_t objects = 0;
+    uint64_t sharedUs = 0;          ///< Switch by rewriting the token styles
+    uint64_t localUs = 0;           ///< Same colors set as local styles object by object
+};
+
+/**
+ * @brief Switch the theme, the dark theme is in effect until the first call
+ */
+void _lvSetTheme(const style::Theme& theme);
+const style::Theme& _lvGetTheme();
+
+/**
+ * @brief Style the object with a token, replacing the token of the same kind set before
+ */
+void _lvSetBgColorToken(lv_obj_t* obj, style::ColorToken token);
+void _lvSetTextColorToken(lv_obj_t* obj, style::ColorToken token);
+void _lvSetPaddingToken(lv_obj_t* obj, style::SpacingToken token);
+void _lvSetRadiusToken(lv_obj_t* obj, style::RadiusToken token);
+void _lvSetFontToken(lv_obj_t* obj, style::FontToken token);
+
+/**
+ * @brief Time a theme switch of a screen of objects with a background and a text color token each
+ *
+ * Needs a display. Only the restyling is timed, layout and redraw are the same for both ways.
+ */
+ThemeSwitchBenchmark _lvBenchmarkThemeSwitch(uint32_t objects);
+
+// ==================== Chart ====================
+// A line chart over the newest samples of each series. Once per display refresh the chart pulls the new
+// samples from its sources, reduces the window to a minimum and a maximum per pixel column and redraws.
+// All functions run on the UI thread.
+
+/**
+ * @brief Move up to max samples into values, oldest first, and return how many, called on the UI thread
+ */
+using ChartSource = std::function<size_t(float* values, size_t max)>;
+
+struct ChartStats
+{
+    uint32_t series = 0;
+    uint32_t frames = 0;            ///< Redraws, frames without new samples are skipped
+    uint64_t samples = 0;           ///< Samples pulled from the sources
+    uint32_t columns = 0;           ///< Pixel columns of the last redraw
+    uint64_t totalFrameUs = 0;      ///< UI thread time of the redraws, pulling included
+    uint64_t maxFrameUs = 0;
+
+    double avgFrameUs() const { return frames ? double(totalFrameUs) / frames : 0.0; }
+};
+
+struct DecimationBenchmark
+{
+    const char* path = "";          ///< Vector path used by the chart
+    double scalarUs = 0.0;          ///< Per round, i.e. per series and frame
+    double vectorUs = 0.0;
+};
+
+lv_obj_t* _lvCreateChart(lv_obj_t* parent);
+
+/**
+ * @brief Add a series drawn in color (its alpha is ignored), the source is kept until the object is deleted
+ * @return Index of the series
+ */
+size_t _lvAddChartSeries(lv_obj_t* obj, const style::Color& color, ChartSource source);
+void _lvSetChartRange(lv_obj_t* obj, int min, int max);
+
+/**
+ * @brief Set the number of newest samples shown per series
+ */
+void _lvSetChartWindow(lv_obj_t* obj, uint32_t samples);
+ChartStats _lvGetChartStats(lv_obj_t* obj);
+
+/**
+ * @brief Time the decimation of one window into columns, scalar against the vector path
+ */
+DecimationBenchmark _lvBenchmarkDecimation(uint32_t samples, uint32_t columns, uint32_t rounds);
+
+// ==================== Image ====================
+// Decoded images are kept in an LRU cache bounded by bytes. Decoding is thread-safe and meant to run on a
+// worker, everything else runs on the UI thread. An object keeps the image it shows alive, eviction only
+// drops the cache's reference.
+
+struct DecodedImage;
+using ImageRef = std::shared_ptr<const DecodedImage>;
+
+/**
+ * @brief One load of an image into an object, a later load or the deletion of the object makes it stale
+ */
+struct ImageTicket
+{
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+    uint32_t sequence = 0;
+    uint64_t startUs = 0;
+};
+
+struct ImageCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t failures = 0;          ///< Files that could not be read or decoded
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t capacityBytes = 0;
+    uint32_t loads = 0;             ///< Decoded loads shown on their object
+    uint64_t totalFirstPixelUs = 0; ///< Sum over the loads, from the request to the source being set
+    uint64_t maxFirstPixelUs = 0;
+
+    double hitRate() const
+    {
+        uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+    double avgFirstPixelUs() const { return loads ? double(totalFirstPixelUs) / loads : 0.0; }
+};
+
+lv_obj_t* _lvCreateImage(lv_obj_t* parent);
+
+/**
+ * @brief Show the cached image of path right away
+ * @return false on a miss, the image has to be loaded with _lvBeginImageLoad/_lvFinishImageLoad
+ */
+bool _lvShowCachedImage(lv_obj_t* obj, const char* path);
+ImageTicket _lvBeginImageLoad(lv_obj_t* obj);
+
+/**
+ * @brief Read and decode an image file into the color format of the LVGL build
+ * @note Thread-safe, does not touch LVGL state
+ * @return nullptr if the file is missing or the format is not supported
+ */
+ImageRef _lvDecodeImage(const char* path);
+
+/**
+ * @brief Cache the decoded image and show it on the object of the ticket
+ * @return false if the ticket is stale or decoding failed, the image is cached anyway
+ */
+bool _lvFinishImageLoad(const ImageTicket& ticket, const char* path, ImageRef image);
+
+void _lvSetImageCacheCapacity(size_t bytes);
+ImageCacheStats _lvGetImageCacheStats();
+void _lvResetImageCacheStats();
+
+// ==================== Asset packs ====================
+// Packs (see AssetPack.h) are mapped read-only, their images are drawn straight from the mapping without
+// decoding or copying. An object showing a packed image keeps the mapping alive.
+
+struct AssetPackStats
+{
+    uint32_t packs = 0;
+    uint32_t images = 0;
+    size_t mappedBytes = 0;
+    uint64_t mountUs = 0;       ///< Total time spent mapping and validating the packs
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+struct AssetLoadBenchmark
+{
+    uint32_t images = 0;
+    uint64_t packUs = 0;    ///< Mapping the pack and reading every image once
+    uint64_t filesUs = 0;   ///< Reading and decoding every image from its own file
+};
+
+/**
+ * @brief Map an asset pack, its images are looked up before the image cache
+ * @return -1 if the file is not a valid pack for this LVGL build
+ */
+int _lvMountAssetPack(const char* path);
+void _lvUnmountAssetPacks();
+
+/**
+ * @brief Show the image stored under name in a mounted pack
+ * @return false if no pack contains it
+ */
+bool _lvShowPackedImage(lv_obj_t* obj, const char* name);
+AssetPackStats _lvGetAssetPackStats();
+
+/**
+ * @brief Compare the start-up cost of a pack against loading the same images one file at a time
+ * @param[in] files Images to load, each has to be in the pack under the same name
+ * @note Both runs use the OS page cache as it is, drop it beforehand to measure cold loads
+ */
+AssetLoadBenchmark _lvBenchmarkAssetLoad(const char* packPath, const std::vector<std::string>& files);
+
+/**
+ * @brief Set the color and, from its alpha byte, the opacity of the background or the text
+ */
 void _lvSetBgColor(lv_obj_t* obj, const style::Color& color);
 void _lvSetTextColor(lv_obj_t* obj, const style::Color& color);
+void _lvSetEnabled(lv_obj_t* obj, bool isEnabled);
+void _lvSetSize(lv_obj_t* obj, const style::Size& size);
+void _lvSetWidth(lv_obj_t* obj, int width);
+void _lvSetHeight(lv_obj_t* obj, int height);
+
+// ==================== Value callbacks ====================
+// The policy limits how often the callback runs while the value keeps changing, e.g. during a drag
+
+lv_obj_t* _lvCreateSlider(lv_obj_t* parent);
+void _lvSetSliderRange(lv_obj_t* obj, int min, int max);
+void _lvSetSliderValue(lv_obj_t* obj, int value, bool anim);
+void _lvSetSliderOnValueChanged(lv_obj_t* obj, std::function<void(int)> callback,
+                                const EventPolicy& policy = EventPolicy::immediate());
+
+// ==================== Bar ====================
+
+lv_obj_t* _lvCreateBar(lv_obj_t* parent, int value);
+lv_obj_t* _lvCreateProgressBar(lv_obj_t* parent, int value);
+void _lvSetBarRange(lv_obj_t* obj, int min, int max);
+void _lvSetBarValue(lv_obj_t* obj, int value, bool anim);
+
+/**
+ * @brief Length of the indicator track in pixels, 0 before the first layout
+ */
+int32_t _lvGetBarTrackLength(lv_obj_t* obj);
+bool _lvIsBarAnimating(lv_obj_t* obj);
+
+/**
+ * @brief Milliseconds since start, wraps around
+ */
+uint32_t _lvTickGet();
+
+void _lvSetBarOnValueChanged(lv_obj_t* obj, std::function<void(int)> callback,
+                             const EventPolicy& policy = EventPolicy::immediate());
+void _lvSetTextAreaOnTextChanged(lv_obj_t* obj, std::function<void(const std::string&)> callback,
+                                 const EventPolicy& policy = EventPolicy::immediate());
+
+// ==================== Text area ====================
+
+/**
+ * @brief One change of a text area, positions and lengths count characters (not bytes)
+ * @note inserted is only valid during the callback
+ */
+struct TextEdit
+{
+    uint32_t position = 0;
+    uint32_t removed = 0;
+    std::string_view inserted;
+};
+
+lv_obj_t* _lvCreateTextArea(lv_obj_t* parent, const char* placeholder);
+void _lvSetTextAreaText(lv_obj_t* obj, const char* text);
+void _lvSetTextAreaPlaceholder(lv_obj_t* obj, const char* placeholder);
+void _lvSetTextAreaMaxLength(lv_obj_t* obj, uint32_t max_len);
+
+/**
+ * @brief Report changes as edits instead of the whole text
+ * @param[in] coalesce Collect the edits and deliver them once per timer cycle, adjacent typing and
+ *                     backspacing merge into one edit
+ */
+void _lvSetTextAreaOnEdit(lv_obj_t* obj, std::function<void(const TextEdit&)> callback, bool coalesce);
+
+/**
+ * @brief Cut characters and append text at the end in one update, for append-only content such as logs
+ * @param[in] cutPosition First character to cut
+ * @param[in] cutLength Characters to cut, 0 for none
+ */
+void _lvAppendTextAreaText(lv_obj_t* obj, const char* text, uint32_t cutPosition, uint32_t cutLength);
+
+// ==================== Spinner ====================
+
+lv_obj_t* _lvCreateSpinner(lv_obj_t* parent);
+
+/**
+ * @brief Not supported by LVGL after creation, the spinner keeps its default animation
+ */
+void _lvSetSpinnerTime(lv_obj_t* obj, uint32_t time);
+void _lvSetSpinnerAngle(lv_obj_t* obj, uint16_t angle);
+
+// ==================== Switch / Checkbox ====================
+
+lv_obj_t* _lvCreateSwitch(lv_obj_t* parent);
+void _lvSetSwitchState(lv_obj_t* obj, bool isOn);
+void _lvSetSwitchOnToggle(lv_obj_t* obj, std::function<void(bool)> callback);
+
+lv_obj_t* _lvCreateCheckbox(lv_obj_t* parent);
+void _lvSetCheckboxText(lv_obj_t* obj, const char* text);
+void _lvSetCheckboxState(lv_obj_t* obj, bool isChecked);
+void _lvSetCheckboxOnToggle(lv_obj_t* obj, std::function<void(bool)> callback);
 
 } // namespace adaptor
 } // namespace gui
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gui {
+
+// ==================== Asset pack format ====================
+// Images packed into one file that is mapped read-only and drawn in place, written by tools/AssetPacker.
+//
+//   AssetPackHeader
+//   AssetPackEntry[count]       sorted by name (strcmp)
+//   image data                  each entry starts at a multiple of kAssetPackAlignment
+//
+// The image data is the pixel part of LVGL's binary image format (.bin without its 4 byte header), i.e. it is
+// already in the color format of the LVGL build. A pack only loads on a build with the LV_COLOR_DEPTH and
+// LV_COLOR_16_SWAP it was packed for. All fields use the byte order of the target.
+
+constexpr uint32_t kAssetPackMagic = 0x31504147;    // "GAP1"
+constexpr uint32_t kAssetPackVersion = 2;
+constexpr uint32_t kAssetPackAlignment = 64;
+constexpr size_t kAssetNameSize = 56;
+
+// AssetPackHeader::flags
+constexpr uint32_t kAssetPackColor16Swap = 1u << 0;    ///< 16 bit pixels have their bytes swapped (LV_COLOR_16_SWAP)
+
+struct AssetPackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t colorDepth;    ///< LV_COLOR_DEPTH of the image data
+    uint32_t flags;         ///< kAssetPack* flags
+};
+
+struct AssetPackEntry
+{
+    char name[kAssetNameSize];  ///< Image source name, NUL terminated
+    uint32_t imageHeader;       ///< lv_img_header_t as stored in the .bin file
+    uint32_t offset;            ///< From the start of the file
+    uint32_t size;              ///< Bytes of image data
+    uint32_t reserved;
+};
+
+static_assert(sizeof(AssetPackHeader) == 20, "AssetPackHeader is part of the file format");
+static_assert(sizeof(AssetPackEntry) == 72, "AssetPackEntry is part of the file format");
+
+} // namespace gui
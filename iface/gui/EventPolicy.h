@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gui {
+
+/**
+ * @brief Delivery policy of a value callback, e.g. to limit the callbacks of a slider drag
+ *
+ * Deferred deliveries run on the UI thread from an LVGL timer and read the value from the object when they
+ * fire, so a trailing delivery always reports the latest value.
+ */
+struct EventPolicy
+{
+    enum class Mode : uint8_t {
+        Immediate,
+        Throttle,
+        Debounce
+    };
+
+    Mode mode = Mode::Immediate;
+    uint32_t intervalMs = 0;
+    bool leading = true;
+    bool trailing = true;
+
+    /**
+     * @brief Deliver every event as it happens
+     */
+    static constexpr EventPolicy immediate() { return EventPolicy{}; }
+
+    /**
+     * @brief Deliver at most once per interval
+     * @param[in] intervalMs Minimum time between two deliveries
+     * @param[in] leading Deliver the first event of a burst right away
+     * @param[in] trailing Deliver the last value once the interval has passed
+     */
+    static constexpr EventPolicy throttle(uint32_t intervalMs, bool leading = true, bool trailing = true)
+    {
+        return EventPolicy{Mode::Throttle, intervalMs, leading, trailing};
+    }
+
+    /**
+     * @brief Deliver at most perSecond times per second, the final value included
+     */
+    static constexpr EventPolicy maxRate(uint32_t perSecond)
+    {
+        return throttle(perSecond ? 1000 / perSecond : 0);
+    }
+
+    /**
+     * @brief Deliver once the events stopped for quietMs, e.g. when a drag is released
+     */
+    static constexpr EventPolicy debounce(uint32_t quietMs, bool leading = false)
+    {
+        return EventPolicy{Mode::Debounce, quietMs, leading, true};
+    }
+
+    /**
+     * @brief Merge all events of one timer cycle into a single delivery of the latest value
+     */
+    static constexpr EventPolicy coalesce() { return EventPolicy{Mode::Throttle, 0, false, true}; }
+
+    constexpr bool isImmediate() const { return mode == Mode::Immediate; }
+};
+
+} // namespace gui
@@ -0,0 +1,130 @@
+#include "Executor.h"
+
+#include <algorithm>
+
+namespace gui {
+
+static thread_local bool gIsWorkerThread = false;
+
+static uint64_t elapsed_us(Executor::Clock::time_point since)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(Executor::Clock::now() - since).count();
+    return us > 0 ? static_cast<uint64_t>(us) : 0;
+}
+
+void Executor::start(size_t workers)
+{
+    std::lock_guard<std::mutex> lock(mWorkersMutex);
+    _startLocked(workers);
+}
+
+void Executor::_startLocked(size_t workers)
+{
+    if (!mWorkers.empty()) {
+        return;
+    }
+
+    if (workers == 0) {
+        workers = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 4);
+    }
+    for (size_t i = 0; i < workers; ++i) {
+        auto worker = std::make_unique<Worker>();
+        Worker& ref = *worker;
+        worker->thread = std::thread([&ref]() { _run(ref); });
+        mWorkers.push_back(std::move(worker));
+    }
+}
+
+void Executor::stop()
+{
+    std::lock_guard<std::mutex> lock(mWorkersMutex);
+    for (auto& worker : mWorkers) {
+        {
+            std::lock_guard<std::mutex> workerLock(worker->mutex);
+            worker->stopping = true;
+        }
+        worker->cv.notify_one();
+    }
+    for (auto& worker : mWorkers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    mWorkers.clear();
+}
+
+void Executor::post(const void* key, std::function<void()> task)
+{
+    Worker* worker;
+    {
+        std::lock_guard<std::mutex> lock(mWorkersMutex);
+        _startLocked(0);
+        size_t index = std::hash<const void*>()(key) % mWorkers.size();
+        worker = mWorkers[index].get();
+    }
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->tasks.push_back(std::move(task));
+    }
+    worker->cv.notify_one();
+}
+
+void Executor::_run(Worker& worker)
+{
+    gIsWorkerThread = true;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            worker.cv.wait(lock, [&worker]() { return worker.stopping || !worker.tasks.empty(); });
+            if (worker.tasks.empty()) {
+                return;
+            }
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            // TODO: LOG ERROR
+        }
+    }
+}
+
+bool Executor::isWorkerThread()
+{
+    return gIsWorkerThread;
+}
+
+Executor::LatencyStats Executor::stats() const
+{
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    return mStats;
+}
+
+void Executor::resetStats()
+{
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    mStats = LatencyStats{};
+}
+
+void Executor::_recordEventToHandler(Clock::time_point queued)
+{
+    uint64_t us = elapsed_us(queued);
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    ++mStats.events;
+    mStats.eventToHandlerTotalUs += us;
+    mStats.eventToHandlerMaxUs = std::max(mStats.eventToHandlerMaxUs, us);
+}
+
+void Executor::_recordHandlerToUi(Clock::time_point posted)
+{
+    uint64_t us = elapsed_us(posted);
+    std::lock_guard<std::mutex> lock(mStatsMutex);
+    ++mStats.uiUpdates;
+    mStats.handlerToUiTotalUs += us;
+    mStats.handlerToUiMaxUs = std::max(mStats.handlerToUiMaxUs, us);
+}
+
+} // namespace gui
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gui {
+
+/**
+ * @brief Thread an event callback runs on
+ */
+enum class CallbackThread {
+    Ui,     ///< Inline in the LVGL event, UI changes apply immediately
+    Worker  ///< On the Executor, UI changes are marshalled back through Render
+};
+
+/**
+ * @brief Worker threads for event callbacks that must not block rendering
+ *
+ * Tasks with the same key (e.g. the lv_obj_t of a widget) always run on the same worker, so the callbacks
+ * of one widget keep their order. UI updates made from a worker go through Render as usual.
+ */
+class Executor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct LatencyStats
+    {
+        uint64_t events = 0;
+        uint64_t eventToHandlerTotalUs = 0;
+        uint64_t eventToHandlerMaxUs = 0;
+        uint64_t uiUpdates = 0;
+        uint64_t handlerToUiTotalUs = 0;
+        uint64_t handlerToUiMaxUs = 0;
+
+        double eventToHandlerAvgUs() const { return events ? double(eventToHandlerTotalUs) / double(events) : 0.0; }
+        double handlerToUiAvgUs() const { return uiUpdates ? double(handlerToUiTotalUs) / double(uiUpdates) : 0.0; }
+    };
+
+    static Executor& instance()
+    {
+        static Executor sInstance;
+        return sInstance;
+    }
+
+    /**
+     * @brief Start the workers, called on first use otherwise
+     * @param[in] workers Number of threads, 0 picks one per core up to 4
+     */
+    void start(size_t workers = 0);
+    void stop();
+
+    /**
+     * @brief Run a task on the worker owning key
+     * @param[in] key Ordering key, tasks of the same key run one after another in posting order
+     */
+    void post(const void* key, std::function<void()> task);
+
+    /**
+     * @brief Wrap a callback so that calling it from the UI thread runs it on a worker
+     * @note The arguments are copied on the UI thread, i.e. the widget value is read when the event happens
+     */
+    template <typename... Args>
+    std::function<void(Args...)> wrap(const void* key, std::function<void(Args...)> callback)
+    {
+        if (!callback) {
+            return callback;
+        }
+        return [this, key, callback = std::move(callback)](Args... args) {
+            auto queued = Clock::now();
+            post(key, [this, queued, callback, args...]() {
+                _recordEventToHandler(queued);
+                callback(args...);
+            });
+        };
+    }
+
+    /**
+     * @brief Whether the calling thread is one of the workers
+     */
+    static bool isWorkerThread();
+
+    LatencyStats stats() const;
+    void resetStats();
+
+    void _recordEventToHandler(Clock::time_point queued);
+    void _recordHandlerToUi(Clock::time_point posted);
+
+private:
+    struct Worker
+    {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::function<void()>> tasks;
+        bool stopping = false;
+    };
+
+    Executor() = default;
+    ~Executor() { stop(); }
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    void _startLocked(size_t workers);
+    static void _run(Worker& worker);
+
+private:
+    std::mutex mWorkersMutex;
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+
+    mutable std::mutex mStatsMutex;
+    LatencyStats mStats;
+};
+
+} // namespace gui
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <utility>
+
+namespace gui {
+
+/**
+ * @brief Value holder that remembers whether it changed since it was last applied to LVGL
+ */
+template <typename T>
+class Property
+{
+public:
+    Property() = default;
+    explicit Property(T value) : mValue(std::move(value)), mHasValue(true), mDirty(true) {}
+
+    /**
+     * @brief Store a new value
+     * @param[in] value New value
+     * @return true if the stored value actually changed
+     */
+    bool set(T value)
+    {
+        if (mHasValue && mValue == value) {
+            return false;
+        }
+        mValue = std::move(value);
+        mHasValue = true;
+        mDirty = true;
+        return true;
+    }
+
+    const T& get() const { return mValue; }
+    bool hasValue() const { return mHasValue; }
+    bool isDirty() const { return mDirty; }
+
+    /**
+     * @brief Check whether the value has to be pushed to LVGL and clear the dirty flag
+     * @param[in] force Apply any stored value, e.g. right after the LVGL object was created
+     * @return true if the caller should apply the value
+     */
+    bool consume(bool force)
+    {
+        bool needed = mHasValue && (force || mDirty);
+        mDirty = false;
+        return needed;
+    }
+
+private:
+    T mValue{};
+    bool mHasValue = false;
+    bool mDirty = false;
+};
+
+} // namespace gui
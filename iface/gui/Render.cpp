@@ -0,0 +1,83 @@
+#include "Render.h"
+#include "ViewBase.h"
+
+#include <algorithm>
+
+namespace gui {
+
+void Render::flushDirty()
+{
+    std::lock_guard<std::recursive_mutex> lock(mPropertyMutex);
+    mFlushScheduled = false;
+
+    // Views marked dirty while flushing land in mDirtyViews and are picked up next frame
+    mFlushingViews.swap(mDirtyViews);
+    for (auto* view : mFlushingViews) {
+        if (!view) {
+            continue;
+        }
+        view->mIsDirty = false;
+        const char* previousTag = adaptor::_lvSetRedrawTag(view->_redrawTag());
+        view->_flushDirty();
+        adaptor::_lvSetRedrawTag(previousTag);
+    }
+    mFlushingViews.clear();
+}
+
+void Render::_enqueueDirty(ViewBase* view)
+{
+    if (_runsInline()) {
+        const char* previousTag = adaptor::_lvSetRedrawTag(view->_redrawTag());
+        view->_flushDirty();
+        adaptor::_lvSetRedrawTag(previousTag);
+        return;
+    }
+
+    _scheduleDirty(view);
+}
+
+bool Render::_deferDirty(ViewBase* view)
+{
+    if (!mIsLooping) {
+        return false;
+    }
+    if (view->mIsDirty) {
+        return true;
+    }
+    view->mIsDirty = true;
+    mDeferredViews.push_back(view);
+    if (!mDeferScheduled) {
+        mDeferScheduled = true;
+        adaptor::_lvCallNextFrame([this]() { _flushDeferred(); });
+    }
+    return true;
+}
+
+void Render::_flushDeferred()
+{
+    std::lock_guard<std::recursive_mutex> lock(mPropertyMutex);
+    mDeferScheduled = false;
+    mDirtyViews.insert(mDirtyViews.end(), mDeferredViews.begin(), mDeferredViews.end());
+    mDeferredViews.clear();
+    flushDirty();
+}
+
+void Render::_scheduleDirty(ViewBase* view)
+{
+    view->mIsDirty = true;
+    mDirtyViews.push_back(view);
+    if (!mFlushScheduled) {
+        mFlushScheduled = true;
+        postRaw([this]() { flushDirty(); });
+    }
+}
+
+void Render::_dequeueDirty(ViewBase* view)
+{
+    mDirtyViews.erase(std::remove(mDirtyViews.begin(), mDirtyViews.end(), view), mDirtyViews.end());
+    mDeferredViews.erase(std::remove(mDeferredViews.begin(), mDeferredViews.end(), view), mDeferredViews.end());
+    std::replace(mFlushingViews.begin(), mFlushingViews.end(), view, static_cast<ViewBase*>(nullptr));
+    view->mIsDirty = false;
+}
+
+} // namespace gui
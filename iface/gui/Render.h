@@ -1,14 +1,20 @@
 #pragma once
 
 #include "Adaptor.h"
+#include "Executor.h"
 
 #include <atomic>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace gui {
 
+class ViewBase;
+
 class Render
 {
 public:
@@ -19,18 +25,23 @@ public:
     }
 
     [[nodiscard]] int preinit() { return adaptor::_lvPreinit(); }
-    [[nodiscard]] int init() { return adaptor::_lvInit(); }
+    [[nodiscard]] int init()
+    {
+        mUiThread = std::this_thread::get_id();
+        return adaptor::_lvInit();
+    }
     void deinit() { adaptor::_lvDeinit(); }
     
     void loop() 
     { 
+        mUiThread = std::this_thread::get_id();
         mIsLooping = true;
         adaptor::_lvLoop();
     }
 
     void post(lv_obj_t* obj, std::function<void(lv_obj_t*)> task) 
     { 
-        if (!mIsLooping) {
+        if (_runsInline()) {
             task(obj);
             return;
         }
@@ -44,7 +55,7 @@ public:
     template <typename T>
     void post(lv_obj_t* obj, T data, std::function<void(lv_obj_t*, T)> task) 
     { 
-        if (!mIsLooping) {
+        if (_runsInline()) {
             task(obj, data);
             return;
         }
@@ -58,7 +69,7 @@ public:
     template <typename ReturnValue>
     ReturnValue exec(lv_obj_t* obj, std::function<ReturnValue(lv_obj_t*)> task)
     {
-        if (!mIsLooping) {
+        if (_runsInline()) {
             return task(obj);
         }
 
@@ -70,7 +81,7 @@ public:
     template <typename ReturnValue, typename Arg>
     ReturnValue exec(lv_obj_t* obj, Arg data, std::function<ReturnValue(lv_obj_t*, Arg)> task)
     {
-        if (!mIsLooping) {
+        if (_runsInline()) {
             return task(obj, data);
         }
 
@@ -79,12 +90,57 @@ public:
         });
     }
 
+    // ==================== Dirty properties ====================
+    /**
+     * @brief Push all pending property changes to LVGL
+     * @note Runs on the UI thread, scheduled at most once per frame
+     */
+    void flushDirty();
+
+    /**
+     * @brief Queue a view whose properties changed since the last frame
+     * @param[in] view Built view, the caller holds the property lock
+     */
+    void _enqueueDirty(ViewBase* view);
+
+    /**
+     * @brief Keep a view queued for the next frame, e.g. while an animation of the object still runs
+     * @note The view is checked again once the display refreshed, not within the same lv_timer_handler
+     * @return false if no frame loop runs, the caller has to apply the change right away
+     */
+    bool _deferDirty(ViewBase* view);
+    void _dequeueDirty(ViewBase* view);
+
+    std::recursive_mutex& _propertyMutex() { return mPropertyMutex; }
+
+    /**
+     * @brief True if a task can touch LVGL right away: no frame loop runs and the caller is the UI thread
+     * @note Before init() any thread but the workers counts as the UI thread
+     */
+    bool _runsInline() const
+    {
+        if (mIsLooping) return false;
+        std::thread::id ui = mUiThread;
+        return ui == std::thread::id() ? !Executor::isWorkerThread() : ui == std::this_thread::get_id();
+    }
+
 protected:
     void postRaw(std::function<void()> task)
     {
-        adaptor::_lvAsyncCall(task);
+        if (Executor::isWorkerThread()) {
+            // UI update requested by an offloaded handler, measure how long it waits for the UI thread
+            adaptor::_lvAsyncCall([posted = Executor::Clock::now(), taskCopy = std::move(task)]() {
+                Executor::instance()._recordHandlerToUi(posted);
+                taskCopy();
+            });
+            return;
+        }
+        adaptor::_lvAsyncCall(std::move(task));
     };
 
+    void _scheduleDirty(ViewBase* view);
+    void _flushDeferred();
+
     template <typename ReturnValue>
     ReturnValue execRaw(std::function<ReturnValue()> task)
     {
@@ -114,6 +170,14 @@ private:
 
 protected:
     std::atomic<bool> mIsLooping = false;
+    std::atomic<std::thread::id> mUiThread{};
+
+    std::recursive_mutex mPropertyMutex;
+    std::vector<ViewBase*> mDirtyViews;
+    std::vector<ViewBase*> mFlushingViews;
+    std::vector<ViewBase*> mDeferredViews;
+    bool mFlushScheduled = false;
+    bool mDeferScheduled = false;
 };
 
 } // namespace gui
\ No newline at end of file
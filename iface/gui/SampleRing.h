@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gui {
+
+/**
+ * @brief Lock-free ring for one producer thread and one consumer thread
+ *
+ * The producer never blocks, a sample that does not fit is dropped and counted. The positions run freely
+ * and are masked with the power of two capacity.
+ */
+template <typename T>
+class SampleRing
+{
+public:
+    explicit SampleRing(size_t capacity) : mSlots(_roundUp(capacity)), mMask(mSlots.size() - 1) {}
+
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    size_t capacity() const { return mSlots.size(); }
+
+    /**
+     * @brief Producer only
+     * @return false if the ring is full and the value was dropped
+     */
+    bool push(const T& value) { return push(&value, 1) == 1; }
+
+    /**
+     * @brief Producer only
+     * @return Number of values stored, the rest was dropped
+     */
+    size_t push(const T* values, size_t count)
+    {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTailCache + count > mSlots.size()) {
+            // Only look at the consumer's cache line when the cached position says the ring is full
+            mTailCache = mTail.load(std::memory_order_acquire);
+        }
+        size_t stored = std::min(count, mSlots.size() - (head - mTailCache));
+        for (size_t i = 0; i < stored; ++i) {
+            mSlots[(head + i) & mMask] = values[i];
+        }
+        mHead.store(head + stored, std::memory_order_release);
+        if (stored < count) {
+            mDropped.fetch_add(count - stored, std::memory_order_relaxed);
+        }
+        return stored;
+    }
+
+    /**
+     * @brief Consumer only, move up to max values out, oldest first
+     * @return Number of values written to out
+     */
+    size_t pop(T* out, size_t max)
+    {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        if (mHeadCache - tail < max) {
+            mHeadCache = mHead.load(std::memory_order_acquire);
+        }
+        size_t count = std::min(max, mHeadCache - tail);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = mSlots[(tail + i) & mMask];
+        }
+        mTail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Values dropped because the ring was full, any thread
+     */
+    uint64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    static size_t _roundUp(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    std::vector<T> mSlots;
+    const size_t mMask;
+    std::atomic<uint64_t> mDropped{0};
+
+    // Producer and consumer each write their own cache line
+    alignas(64) std::atomic<size_t> mHead{0};
+    size_t mTailCache = 0;
+    alignas(64) std::atomic<size_t> mTail{0};
+    size_t mHeadCache = 0;
+};
+
+} // namespace gui
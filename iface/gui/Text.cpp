@@ -0,0 +1,46 @@
+#include "Text.h"
+
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <set>
+
+namespace gui {
+
+Text::Text(std::string_view str)
+{
+    if (str.empty()) {
+        return;
+    }
+
+    void* memory = ::operator new(sizeof(Buffer) + str.size() + 1);
+    mBuffer = new (memory) Buffer{{1}};
+    std::memcpy(mBuffer->data(), str.data(), str.size());
+    mBuffer->data()[str.size()] = '\0';
+    mData = mBuffer->data();
+    mSize = static_cast<uint32_t>(str.size());
+}
+
+void Text::_release()
+{
+    if (mBuffer && mBuffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        mBuffer->~Buffer();
+        ::operator delete(mBuffer);
+    }
+    mBuffer = nullptr;
+}
+
+Text Text::intern(std::string_view str)
+{
+    static std::mutex sPoolMutex;
+    static std::set<std::string, std::less<>> sPool;
+
+    std::lock_guard<std::mutex> lock(sPoolMutex);
+    auto it = sPool.find(str);
+    if (it == sPool.end()) {
+        it = sPool.emplace(str).first;
+    }
+    return fromStatic(it->c_str(), it->size());
+}
+
+} // namespace gui
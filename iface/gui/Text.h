@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace gui {
+
+/**
+ * @brief Immutable UI string
+ *
+ * Static texts (literals, interned strings) are referenced in place and can be handed to LVGL without
+ * copying. Dynamic texts share one reference-counted buffer between all copies.
+ */
+class Text
+{
+public:
+    Text() = default;
+    Text(const char* str) : Text(std::string_view(str ? str : "")) {}
+    Text(const std::string& str) : Text(std::string_view(str)) {}
+    Text(std::string_view str);
+
+    Text(const Text& o) : mData(o.mData), mSize(o.mSize), mBuffer(o.mBuffer) { _retain(); }
+    Text(Text&& o) noexcept : mData(o.mData), mSize(o.mSize), mBuffer(o.mBuffer)
+    {
+        o.mData = "";
+        o.mSize = 0;
+        o.mBuffer = nullptr;
+    }
+
+    Text& operator=(Text o) noexcept
+    {
+        std::swap(mData, o.mData);
+        std::swap(mSize, o.mSize);
+        std::swap(mBuffer, o.mBuffer);
+        return *this;
+    }
+
+    ~Text() { _release(); }
+
+    /**
+     * @brief Reference a string with static storage duration without copying
+     * @param[in] str String that outlives every LVGL object using it, e.g. a literal
+     * @param[in] size Length of the string in bytes
+     */
+    static Text fromStatic(const char* str, size_t size)
+    {
+        Text text;
+        text.mData = str;
+        text.mSize = static_cast<uint32_t>(size);
+        return text;
+    }
+
+    /**
+     * @brief Return the pooled copy of the string, allocating it only on first use
+     * @note Interned strings are never freed, use it for the fixed vocabulary of the UI
+     */
+    static Text intern(std::string_view str);
+
+    const char* c_str() const { return mData; }
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+    std::string_view view() const { return std::string_view(mData, mSize); }
+
+    /**
+     * @brief Whether the storage outlives any LVGL object, i.e. it can be set with lv_label_set_text_static
+     */
+    bool isStatic() const { return mBuffer == nullptr; }
+
+    bool operator==(const Text& o) const { return mData == o.mData || view() == o.view(); }
+    bool operator!=(const Text& o) const { return !(*this == o); }
+
+private:
+    struct Buffer
+    {
+        std::atomic<uint32_t> refs;
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    void _retain()
+    {
+        if (mBuffer) {
+            mBuffer->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void _release();
+
+private:
+    const char* mData = "";
+    uint32_t mSize = 0;
+    Buffer* mBuffer = nullptr;
+};
+
+namespace literals {
+
+inline Text operator""_txt(const char* str, size_t size)
+{
+    return Text::fromStatic(str, size);
+}
+
+} // namespace literals
+} // namespace gui
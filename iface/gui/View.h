@@ -3,11 +3,13 @@
 #include "Adaptor.h"
 #include "ViewBase.h"
 #include "Modifier.h"
+#include "Property.h"
 
 #include "style/Size.h"
 #include "style/Position.h"
 #include "style/Color.h"
 #include "style/Layout.h"
+#include "style/Theme.h"
 
 #include <string>
 
@@ -25,7 +27,7 @@ public:
 
     Derived& backgroundColor(style::Color color) & 
     {
-        custom([color](lv_obj_t* obj){ adaptor::_lvSetBgColor(obj, color); });
+        this->_updateProperty([&] { return mBgColor.set(color); });
         return lself();
     }
     Derived&& backgroundColor(style::Color color) && 
@@ -35,7 +37,7 @@ public:
     
     Derived& foregroundColor(style::Color color) & 
     {
-        custom([color](lv_obj_t* obj){ adaptor::_lvSetTextColor(obj, color); });
+        this->_updateProperty([&] { return mFgColor.set(color); });
         return lself();
     }
     Derived&& foregroundColor(style::Color color) && 
@@ -43,12 +45,107 @@ public:
         return std::move(static_cast<Derived&>(*this).foregroundColor(color));
     }
 
+    // Theme tokens follow a theme switch, a color set as value above takes precedence
+
+    Derived& backgroundColor(style::ColorToken token) &
+    {
+        this->_updateProperty([&] { return mBgToken.set(token); });
+        return lself();
+    }
+    Derived&& backgroundColor(style::ColorToken token) &&
+    {
+        return std::move(static_cast<Derived&>(*this).backgroundColor(token));
+    }
+
+    Derived& foregroundColor(style::ColorToken token) &
+    {
+        this->_updateProperty([&] { return mFgToken.set(token); });
+        return lself();
+    }
+    Derived&& foregroundColor(style::ColorToken token) &&
+    {
+        return std::move(static_cast<Derived&>(*this).foregroundColor(token));
+    }
+
+    Derived& padding(style::SpacingToken token) &
+    {
+        this->_updateProperty([&] { return mPaddingToken.set(token); });
+        return lself();
+    }
+    Derived&& padding(style::SpacingToken token) &&
+    {
+        return std::move(static_cast<Derived&>(*this).padding(token));
+    }
+
+    Derived& cornerRadius(style::RadiusToken token) &
+    {
+        this->_updateProperty([&] { return mRadiusToken.set(token); });
+        return lself();
+    }
+    Derived&& cornerRadius(style::RadiusToken token) &&
+    {
+        return std::move(static_cast<Derived&>(*this).cornerRadius(token));
+    }
+
+    Derived& font(style::FontToken token) &
+    {
+        this->_updateProperty([&] { return mFontToken.set(token); });
+        return lself();
+    }
+    Derived&& font(style::FontToken token) &&
+    {
+        return std::move(static_cast<Derived&>(*this).font(token));
+    }
+
 protected:
     using Modifier<Derived>::lself;
     using Modifier<Derived>::rself;
     using Modifier<Derived>::_applyAllModifiers;
 
 protected:
+    /**
+     * @brief Apply stored properties to the LVGL object
+     * @param[in] obj Target LVGL object
+     * @param[in] force Apply every stored value instead of only the changed ones
+     */
+    virtual void _applyProperties(lv_obj_t* obj, bool force)
+    {
+        if (mBgColor.consume(force)) {
+            adaptor::_lvSetBgColor(obj, mBgColor.get());
+        }
+        if (mFgColor.consume(force)) {
+            adaptor::_lvSetTextColor(obj, mFgColor.get());
+        }
+        if (mBgToken.consume(force)) {
+            adaptor::_lvSetBgColorToken(obj, mBgToken.get());
+        }
+        if (mFgToken.consume(force)) {
+            adaptor::_lvSetTextColorToken(obj, mFgToken.get());
+        }
+        if (mPaddingToken.consume(force)) {
+            adaptor::_lvSetPaddingToken(obj, mPaddingToken.get());
+        }
+        if (mRadiusToken.consume(force)) {
+            adaptor::_lvSetRadiusToken(obj, mRadiusToken.get());
+        }
+        if (mFontToken.consume(force)) {
+            adaptor::_lvSetFontToken(obj, mFontToken.get());
+        }
+    }
+
+    void _applyBuildProperties(lv_obj_t* obj)
+    {
+        std::lock_guard<std::recursive_mutex> lock(this->_propertyMutex());
+        _applyProperties(obj, true);
+    }
+
+    void _flushDirty() override
+    {
+        if (mLvObj) {
+            _applyProperties(mLvObj, false);
+        }
+    }
+
     virtual lv_obj_t* _createLvObj(lv_obj_t* parent) override 
     {
         return adaptor::_lvCreateObj(parent);
@@ -59,11 +156,21 @@ protected:
         if (!mLvObj) {
             mLvObj = _createLvObj(parent);
             if (mLvObj) {
+                _applyBuildProperties(mLvObj);
                 this->_applyAllModifiers(mLvObj);
             }
         }
         return mLvObj;
     }
+
+private:
+    Property<style::Color> mBgColor;
+    Property<style::Color> mFgColor;
+    Property<style::ColorToken> mBgToken;
+    Property<style::ColorToken> mFgToken;
+    Property<style::SpacingToken> mPaddingToken;
+    Property<style::RadiusToken> mRadiusToken;
+    Property<style::FontToken> mFontToken;
 };
 
 } // namespace gui
\ No newline at end of file
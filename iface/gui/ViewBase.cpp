@@ -22,6 +22,43 @@ lv_obj_t* ViewBase::_createLvObj(lv_obj_t* parent)
     return mLvObj;
 }
 
+void ViewBase::_markDirtyLocked()
+{
+    mHasMovedChanges = false;
+    if (!mIsDirty) {
+        Render::instance()._enqueueDirty(this);
+    }
+}
+
+bool ViewBase::_deferDirtyLocked()
+{
+    return Render::instance()._deferDirty(this);
+}
+
+void ViewBase::_cancelDirty()
+{
+    std::lock_guard<std::recursive_mutex> lock(_propertyMutex());
+    if (mIsDirty) {
+        Render::instance()._dequeueDirty(this);
+    }
+}
+
+bool ViewBase::_releaseDirty()
+{
+    std::lock_guard<std::recursive_mutex> lock(_propertyMutex());
+    bool hadChanges = mIsDirty || mHasMovedChanges;
+    if (mIsDirty) {
+        Render::instance()._dequeueDirty(this);
+    }
+    mHasMovedChanges = false;
+    return hadChanges;
+}
+
+std::recursive_mutex& ViewBase::_propertyMutex()
+{
+    return Render::instance()._propertyMutex();
+}
+
 void ViewBase::_destroy() 
 {
     if (mLvObj && !mIsWrapper) {
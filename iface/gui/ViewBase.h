@@ -5,25 +5,67 @@
 #include <string>
 #include <memory>
 #include <atomic>
+#include <mutex>
 
 namespace gui {
 
+class Render;
+
+template <class Derived>
+class Container;
+
 enum class ViewType {
     VStack,
     HStack,
     ZStack,
     Label,
-    Button
+    NumericLabel,
+    Button,
+    List,
+    Bar,
+    ProgressBar,
+    Image,
+    TextArea,
+    LogView,
+    Chart
 };
 
+inline const char* toString(ViewType type)
+{
+    switch (type) {
+        case ViewType::VStack: return "VStack";
+        case ViewType::HStack: return "HStack";
+        case ViewType::ZStack: return "ZStack";
+        case ViewType::Label: return "Label";
+        case ViewType::NumericLabel: return "NumericLabel";
+        case ViewType::Button: return "Button";
+        case ViewType::List: return "List";
+        case ViewType::Bar: return "Bar";
+        case ViewType::ProgressBar: return "ProgressBar";
+        case ViewType::Image: return "Image";
+        case ViewType::TextArea: return "TextArea";
+        case ViewType::LogView: return "LogView";
+        case ViewType::Chart: return "Chart";
+    }
+    return "View";
+}
+
 class ViewBase 
 {
+    friend class Render;
+
+    template <class Derived>
+    friend class Container;
+
 public:
     ViewBase() = default;
     explicit ViewBase(std::string name) : mName(std::move(name)) {}
 
     virtual ~ViewBase() 
     {
+        if (mLvObj) {
+            _cancelDirty();
+        }
         if (mDestroyedPtr) {
             mDestroyedPtr->store(true, std::memory_order_release);
             _destroy();
@@ -35,10 +77,15 @@ public:
 
     ViewBase(ViewBase&& o) noexcept
         : mDestroyedPtr(std::move(o.mDestroyedPtr))
-        , mName(std::move(o.mName))
         , mLvParent(o.mLvParent)
-        , mLvObj(o.mLvObj) 
+        , mLvObj(o.mLvObj)
+        , mName(std::move(o.mName))
     {
+        // The derived part is still being moved, so a flush must not reach this view yet: the queued
+        // changes travel with the dirty properties and the next update of this view queues them again
+        if (mLvObj) {
+            mHasMovedChanges = o._releaseDirty();
+        }
         o.mLvParent = nullptr; 
         o.mLvObj = nullptr;
         o.mIsWrapper = false;
@@ -50,6 +97,9 @@ public:
             return *this;
         }
 
+        if (mLvObj) {
+            _cancelDirty();
+        }
         if (mDestroyedPtr) {
             mDestroyedPtr->store(true, std::memory_order_release);
             _destroy();
@@ -59,6 +109,9 @@ public:
         mName = std::move(o.mName);
         mLvParent = o.mLvParent;
         mLvObj = o.mLvObj;
+        if (mLvObj) {
+            mHasMovedChanges = o._releaseDirty();
+        }
       
         if (o.mDestroyedPtr) {
             o.mDestroyedPtr->store(true, std::memory_order_release);
@@ -81,9 +134,21 @@ public:
      */
     lv_obj_t* create(lv_obj_t* parent) 
     {
-        return _build(parent);
+        const char* previousTag = adaptor::_lvSetRedrawTag(_redrawTag());
+        adaptor::_lvBeginBuild();
+        lv_obj_t* obj = _build(parent);
+        adaptor::_lvEndBuild();
+        adaptor::_lvSetRedrawTag(previousTag);
+        return obj;
     }
     
+    const std::string& name() const { return mName; }
+
+    /**
+     * @brief Name the redraw profiler reports this view under, the view type if it has no name
+     */
+    const char* _redrawTag() const { return mName.empty() ? toString(type()) : mName.c_str(); }
+
     lv_obj_t* _getLvParent() const { return mLvParent; }
     lv_obj_t* _getLvObj() const { return mLvObj; }
 
@@ -92,12 +157,57 @@ protected:
     virtual lv_obj_t* _build(lv_obj_t* parent) = 0;
 
     void _destroy(); 
+
+    // ==================== Dirty properties ====================
+    /**
+     * @brief Mutate properties under the property lock and schedule a flush if the view is built
+     * @param[in] fn Mutation returning true if a property value actually changed
+     */
+    template <typename Fn>
+    void _updateProperty(Fn&& fn)
+    {
+        std::lock_guard<std::recursive_mutex> lock(_propertyMutex());
+        if ((fn() || mHasMovedChanges) && mLvObj) {
+            _markDirtyLocked();
+        }
+    }
+
+    /**
+     * @brief Push changed properties to the LVGL object
+     * @note Runs on the UI thread with the property lock held
+     */
+    virtual void _flushDirty() {}
+
+    // ==================== Delegated events ====================
+    /**
+     * @brief Handle a click the parent container received on behalf of this view
+     */
+    virtual void _onDelegatedClick() {}
+
+    void _markDirtyLocked();
+
+    /**
+     * @brief Postpone the flush of this view to the next frame, called from _flushDirty
+     * @return false if there is no next frame to wait for and the change must be applied now
+     */
+    bool _deferDirtyLocked();
+    void _cancelDirty();
+
+    /**
+     * @brief Take this view out of the flush queue before its properties are moved to another view
+     * @return true if changes were queued, or still pending from an earlier move
+     */
+    bool _releaseDirty();
+    static std::recursive_mutex& _propertyMutex();
     
 protected:
     std::shared_ptr<std::atomic<bool>> mDestroyedPtr;
     lv_obj_t* mLvParent = nullptr;
     lv_obj_t* mLvObj = nullptr;
     bool mIsWrapper = false;
+    bool mIsDirty = false;
+    bool mHasMovedChanges = false;
+    bool mEventsDelegated = false;
     std::string mName;
 };
 
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "../View.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace gui {
+
+/**
+ * @brief Common part of Bar and ProgressBar, pushes values to LVGL only when they are visible
+ *
+ * - A change that moves the indicator by less than one pixel is dropped.
+ * - Values set while the bar animates are merged, only the latest one is applied once the animation ends.
+ * - Updates arriving faster than the animation interval jump to the value instead of restarting the animation.
+ */
+template <class Derived>
+class BarView : public View<Derived>
+{
+public:
+    using View<Derived>::lself;
+
+    struct Range
+    {
+        int min = 0;
+        int max = 100;
+
+        bool operator==(const Range& o) const { return min == o.min && max == o.max; }
+    };
+
+    struct Stats
+    {
+        uint32_t applied = 0;
+        uint32_t animated = 0;
+        uint32_t skippedSubPixel = 0;
+        uint32_t deferred = 0;
+    };
+
+    static constexpr uint32_t kDefaultAnimationIntervalMs = 250;
+
+public:
+    BarView() : mRange(Range{}) {}
+
+    Derived& value(int value) &
+    {
+        this->_updateProperty([&] { return mValue.set(value); });
+        return lself();
+    }
+    Derived&& value(int value) &&
+    {
+        return std::move(static_cast<Derived&>(*this).value(value));
+    }
+
+    Derived& range(int min, int max) &
+    {
+        this->_updateProperty([&] { return mRange.set(Range{min, max}); });
+        return lself();
+    }
+    Derived&& range(int min, int max) &&
+    {
+        return std::move(static_cast<Derived&>(*this).range(min, max));
+    }
+
+    /**
+     * @brief Animate a value change only if the previous update was at least intervalMs ago
+     * @param[in] intervalMs 0 animates every change, UINT32_MAX never animates
+     */
+    Derived& animationInterval(uint32_t intervalMs) &
+    {
+        mAnimationIntervalMs = intervalMs;
+        return lself();
+    }
+    Derived&& animationInterval(uint32_t intervalMs) &&
+    {
+        return std::move(static_cast<Derived&>(*this).animationInterval(intervalMs));
+    }
+
+    const Stats& stats() const { return mStats; }
+
+protected:
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<Derived>::_applyProperties(obj, force);
+        if (mRange.consume(force)) {
+            adaptor::_lvSetBarRange(obj, mRange.get().min, mRange.get().max);
+            // The indicator moved with the range, the shown value no longer tells the pixel position
+            mHasShownValue = false;
+        }
+        if (!mValue.hasValue() || (!force && !mValue.isDirty() && mHasShownValue)) {
+            return;
+        }
+
+        // Every update counts for the rate, including the ones too small to show
+        uint32_t now = adaptor::_lvTickGet();
+        bool isStream = mHasUpdateTick && now - mLastUpdateTick < mAnimationIntervalMs;
+        mLastUpdateTick = now;
+        mHasUpdateTick = true;
+
+        int target = mValue.get();
+        if (!force && adaptor::_lvIsBarAnimating(obj) && this->_deferDirtyLocked()) {
+            ++mStats.deferred;
+            mMergedDuringAnimation = true;
+            return;
+        }
+        mValue.consume(force);
+        if (!force && !_isVisibleChange(obj, target)) {
+            ++mStats.skippedSubPixel;
+            return;
+        }
+
+        // Animating a stream of values would only restart the animation and lag behind
+        bool animate = !force && mHasShownValue && !isStream && !mMergedDuringAnimation;
+        adaptor::_lvSetBarValue(obj, target, animate);
+
+        mMergedDuringAnimation = false;
+        mShownValue = target;
+        mHasShownValue = true;
+        ++mStats.applied;
+        if (animate) {
+            ++mStats.animated;
+        }
+    }
+
+    bool _isVisibleChange(lv_obj_t* obj, int target) const
+    {
+        const Range& range = mRange.get();
+        if (!mHasShownValue || target == range.min || target == range.max) {
+            return true;
+        }
+
+        int64_t length = adaptor::_lvGetBarTrackLength(obj);
+        int64_t span = int64_t(range.max) - range.min;
+        if (length <= 0 || span <= 0) {
+            // Not laid out yet
+            return true;
+        }
+        return (int64_t(target) - range.min) * length / span != (int64_t(mShownValue) - range.min) * length / span;
+    }
+
+    lv_obj_t* _build(lv_obj_t* parent) override
+    {
+        this->mLvObj = this->_createLvObj(parent);
+        if (this->mLvObj) {
+            mHasShownValue = false;
+            this->_applyBuildProperties(this->mLvObj);
+            this->_applyAllModifiers(this->mLvObj);
+        }
+        return this->mLvObj;
+    }
+
+private:
+    Property<int> mValue;
+    Property<Range> mRange;
+    uint32_t mAnimationIntervalMs = kDefaultAnimationIntervalMs;
+
+    int mShownValue = 0;
+    bool mHasShownValue = false;
+    bool mMergedDuringAnimation = false;
+    bool mHasUpdateTick = false;
+    uint32_t mLastUpdateTick = 0;
+    Stats mStats;
+};
+
+class Bar : public BarView<Bar>
+{
+public:
+    Bar() = default;
+    explicit Bar(int value) { this->value(value); }
+
+    ViewType type() const override { return ViewType::Bar; }
+
+protected:
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateBar(parent, 0);
+    }
+};
+
+} // namespace gui
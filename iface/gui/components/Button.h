@@ -1,8 +1,9 @@
 #pragma once
 
 #include "../View.h"
+#include "../Text.h"
+#include "../Executor.h"
 
-#include <string>
 #include <functional>
 
 namespace gui {
@@ -14,29 +15,80 @@ public:
 
 public:
     Button() : View<Button>() {}
-    explicit Button(const std::string& text) : View<Button>(), mText(text) {}
+    explicit Button(Text text) : View<Button>(), mText(std::move(text)) {}
 
     ViewType type() const override { return ViewType::Button; }
     
-    Button& text(const std::string& text) &
+    Button& text(Text text) &
     {
-        mText = text;
-        custom([text](lv_obj_t* obj){ adaptor::_lvSetButtonText(obj, text.c_str()); });
+        _updateProperty([&] { return mText.set(std::move(text)); });
         return *this;
     }
 
-    Button&& text(const std::string& text) &&
+    Button&& text(Text text) &&
     {
-        return std::move(static_cast<Button&>(*this).text(text));
+        return std::move(static_cast<Button&>(*this).text(std::move(text)));
     }
 
-    Button& onClick(OnClickCallback callback)
+    Button& enabled(bool isEnabled) &
+    {
+        _updateProperty([&] { return mEnabled.set(isEnabled); });
+        return *this;
+    }
+
+    Button&& enabled(bool isEnabled) &&
+    {
+        return std::move(static_cast<Button&>(*this).enabled(isEnabled));
+    }
+
+    /**
+     * @brief Set the click handler
+     * @param[in] thread CallbackThread::Worker runs slow handlers off the UI thread, in click order
+     */
+    Button& onClick(OnClickCallback callback, CallbackThread thread = CallbackThread::Ui) &
     {
         mOnClick = std::move(callback);
+        mClickThread = thread;
         return *this;
     }
 
+    Button&& onClick(OnClickCallback callback, CallbackThread thread = CallbackThread::Ui) &&
+    {
+        return std::move(static_cast<Button&>(*this).onClick(std::move(callback), thread));
+    }
+
 protected:
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<Button>::_applyProperties(obj, force);
+        // A button built without text gets no label, clearing the text of a built one must still apply
+        if (mText.consume(force) && !(force && mText.get().empty())) {
+            if (mText.get().isStatic()) {
+                adaptor::_lvSetButtonTextStatic(obj, mText.get().c_str());
+            } else {
+                adaptor::_lvSetButtonText(obj, mText.get().c_str());
+            }
+        }
+        if (mEnabled.consume(force)) {
+            adaptor::_lvSetEnabled(obj, mEnabled.get());
+        }
+    }
+
+    void _onDelegatedClick() override
+    {
+        if (auto handler = _clickHandler()) {
+            handler();
+        }
+    }
+
+    OnClickCallback _clickHandler() const
+    {
+        if (mClickThread == CallbackThread::Worker) {
+            return Executor::instance().wrap(mLvObj, mOnClick);
+        }
+        return mOnClick;
+    }
+
     lv_obj_t* _createLvObj(lv_obj_t* parent) override
     {
         return adaptor::_lvCreateButton(parent);
@@ -46,20 +98,24 @@ protected:
     {
         mLvObj = _createLvObj(parent);
         if (mLvObj) {
-            if (!mText.empty()) {
-                adaptor::_lvSetButtonText(mLvObj, mText.c_str());
-            }
+            _applyBuildProperties(mLvObj);
             this->_applyAllModifiers(mLvObj);
             if (mOnClick) {
-                adaptor::_lvSetOnClick(mLvObj, mOnClick);
+                if (mEventsDelegated) {
+                    adaptor::_lvSetEventBubble(mLvObj, true);
+                } else {
+                    adaptor::_lvSetOnClick(mLvObj, _clickHandler());
+                }
             }
         }
         return mLvObj;
     }
 
 private:
-    std::string mText;
+    Property<Text> mText;
+    Property<bool> mEnabled;
     OnClickCallback mOnClick;
+    CallbackThread mClickThread = CallbackThread::Ui;
 };
 
-} // namespace gui
\ No newline at end of file
+} // namespace gui
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "../SampleRing.h"
+#include "../View.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace gui {
+
+/**
+ * @brief Line chart of live samples, e.g. temperature graphs
+ *
+ * Worker threads push samples into a lock-free ring per series, the UI thread pulls them once per frame and
+ * draws the newest window reduced to a minimum and a maximum per pixel column. Pushing never blocks, a
+ * sample that finds the ring full is dropped and counted.
+ */
+class Chart : public View<Chart>
+{
+public:
+    static constexpr uint32_t kDefaultWindow = 1000;
+    static constexpr size_t kDefaultRingCapacity = 4096;
+
+    struct Range
+    {
+        int min = 0;
+        int max = 100;
+
+        bool operator==(const Range& o) const { return min == o.min && max == o.max; }
+    };
+
+    /**
+     * @brief Producer side of a series, one thread pushes at a time
+     */
+    class Series
+    {
+    public:
+        Series() = default;
+
+        bool push(float value) { return mRing && mRing->push(value); }
+        size_t push(const float* values, size_t count) { return mRing ? mRing->push(values, count) : 0; }
+        uint64_t dropped() const { return mRing ? mRing->dropped() : 0; }
+
+        explicit operator bool() const { return mRing != nullptr; }
+
+    private:
+        friend class Chart;
+        explicit Series(std::shared_ptr<SampleRing<float>> ring) : mRing(std::move(ring)) {}
+
+        std::shared_ptr<SampleRing<float>> mRing;
+    };
+
+public:
+    Chart() : View<Chart>(), mRange(Range{}), mWindow(kDefaultWindow) {}
+
+    ViewType type() const override { return ViewType::Chart; }
+
+    Chart& range(int min, int max) &
+    {
+        _updateProperty([&] { return mRange.set(Range{min, max}); });
+        return lself();
+    }
+    Chart&& range(int min, int max) &&
+    {
+        return std::move(static_cast<Chart&>(*this).range(min, max));
+    }
+
+    /**
+     * @brief Set the number of newest samples shown per series
+     */
+    Chart& window(uint32_t samples) &
+    {
+        _updateProperty([&] { return mWindow.set(samples); });
+        return lself();
+    }
+    Chart&& window(uint32_t samples) &&
+    {
+        return std::move(static_cast<Chart&>(*this).window(samples));
+    }
+
+    /**
+     * @brief Add a series, on the UI thread once built
+     * @param[in] ringCapacity Samples buffered between two frames, rounded up to a power of two
+     * @return Handle for the producer, valid for the lifetime of the chart
+     */
+    Series addSeries(style::Color color, size_t ringCapacity = kDefaultRingCapacity)
+    {
+        mSeries.push_back(SeriesSpec{color, std::make_shared<SampleRing<float>>(ringCapacity)});
+        if (mLvObj) {
+            _addSeries(mLvObj, mSeries.back());
+        }
+        return Series(mSeries.back().ring);
+    }
+
+    /**
+     * @brief Samples dropped on full rings over all series, any thread
+     */
+    uint64_t droppedSamples() const
+    {
+        uint64_t dropped = 0;
+        for (const SeriesSpec& series : mSeries) {
+            dropped += series.ring->dropped();
+        }
+        return dropped;
+    }
+
+    /**
+     * @brief Counters of the per-frame redraw, available once built, call on the UI thread
+     */
+    adaptor::ChartStats renderStats() const
+    {
+        return mLvObj ? adaptor::_lvGetChartStats(mLvObj) : adaptor::ChartStats{};
+    }
+
+protected:
+    struct SeriesSpec
+    {
+        style::Color color;
+        std::shared_ptr<SampleRing<float>> ring;
+    };
+
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<Chart>::_applyProperties(obj, force);
+        if (mRange.consume(force)) {
+            adaptor::_lvSetChartRange(obj, mRange.get().min, mRange.get().max);
+        }
+        if (mWindow.consume(force)) {
+            adaptor::_lvSetChartWindow(obj, mWindow.get());
+        }
+    }
+
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateChart(parent);
+    }
+
+    lv_obj_t* _build(lv_obj_t* parent) override
+    {
+        mLvObj = _createLvObj(parent);
+        if (mLvObj) {
+            _applyBuildProperties(mLvObj);
+            this->_applyAllModifiers(mLvObj);
+            for (const SeriesSpec& series : mSeries) {
+                _addSeries(mLvObj, series);
+            }
+        }
+        return mLvObj;
+    }
+
+    static void _addSeries(lv_obj_t* obj, const SeriesSpec& series)
+    {
+        // The ring outlives a move of the view, the LVGL object keeps pulling from it
+        adaptor::_lvAddChartSeries(obj, series.color, [ring = series.ring](float* values, size_t max) {
+            return ring->pop(values, max);
+        });
+    }
+
+private:
+    Property<Range> mRange;
+    Property<uint32_t> mWindow;
+    std::vector<SeriesSpec> mSeries;
+};
+
+} // namespace gui
@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
 #include <type_traits>
 
 namespace gui {
@@ -15,6 +16,8 @@ public:
     using View<Derived>::lself;
     using View<Derived>::rself;
 
+    using OnChildClickCallback = std::function<void(ViewBase& child, size_t index)>;
+
 public:
     Container() = default;
     explicit Container(std::string name) : View<Derived>(std::move(name)) {}
@@ -45,7 +48,44 @@ public:
         return rself();
     }
 
+    /**
+     * @brief Handle the clicks of all children with one LVGL callback on this container
+     *
+     * Children skip their own callback registration, their clicks bubble up and are routed back to the
+     * child view (e.g. Button::onClick) and to the onChildClick callback.
+     */
+    Derived& delegateEvents(bool isEnabled = true) &
+    {
+        mDelegateEvents = isEnabled;
+        return lself();
+    }
+    Derived&& delegateEvents(bool isEnabled = true) &&
+    {
+        delegateEvents(isEnabled);
+        return rself();
+    }
+
+    /**
+     * @brief Set the click handler of all children, implies delegateEvents()
+     */
+    Derived& onChildClick(OnChildClickCallback callback) &
+    {
+        mOnChildClick = std::move(callback);
+        mDelegateEvents = true;
+        return lself();
+    }
+    Derived&& onChildClick(OnChildClickCallback callback) &&
+    {
+        onChildClick(std::move(callback));
+        return rself();
+    }
+
 protected:
+    static lv_obj_t* _buildChild(ViewBase& child, lv_obj_t* parent)
+    {
+        return child._build(parent);
+    }
+
     virtual lv_obj_t* _createLvObj(lv_obj_t* parent) override
     {
         return adaptor::_lvCreateObj(parent);
@@ -53,24 +93,75 @@ protected:
 
     virtual lv_obj_t* _build(lv_obj_t* parent) override 
     {
-        mLvObj = _createLvObj(parent);
-        if (mLvObj) {
-            _applyAllModifiers(mLvObj);
-            for (auto& child : mChildren) {
-                child->_build(mLvObj);
+        this->mLvObj = _createLvObj(parent);
+        if (this->mLvObj) {
+            this->_applyBuildProperties(this->mLvObj);
+            this->_applyAllModifiers(this->mLvObj);
+            _buildChildren();
+        }
+        return this->mLvObj;
+    }
+
+    void _buildChildren()
+    {
+        // Clicks are mapped by object: a child whose build returned nullptr has no object, and the parent may
+        // hold LVGL objects no child view created. The callback only sees the delegates through a weak
+        // reference, they are released with this view (children are owned through unique_ptr, so moving this
+        // view keeps the addresses valid)
+        auto delegates = std::make_shared<ChildDelegates>();
+        for (size_t i = 0; i < mChildren.size(); ++i) {
+            ViewBase& child = *mChildren[i];
+            child.mEventsDelegated = mDelegateEvents;
+            lv_obj_t* obj = _buildChild(child, this->mLvObj);
+            if (obj && mDelegateEvents) {
+                delegates->push_back(ChildDelegate{obj, &child, i});
             }
         }
-        return mLvObj;
+
+        if (mDelegateEvents) {
+            std::weak_ptr<const ChildDelegates> weakDelegates = delegates;
+            adaptor::_lvSetOnChildClick(this->mLvObj,
+                [weakDelegates, onChildClick = mOnChildClick](lv_obj_t* obj) {
+                    auto delegates = weakDelegates.lock();
+                    if (!delegates) {
+                        return;
+                    }
+                    for (const ChildDelegate& delegate : *delegates) {
+                        if (delegate.obj != obj) {
+                            continue;
+                        }
+                        delegate.view->_onDelegatedClick();
+                        if (onChildClick) {
+                            onChildClick(*delegate.view, delegate.index);
+                        }
+                        return;
+                    }
+                });
+        }
+        mDelegates = std::move(delegates);
     }
 
 protected:
+    struct ChildDelegate
+    {
+        lv_obj_t* obj;
+        ViewBase* view;
+        size_t index;
+    };
+    using ChildDelegates = std::vector<ChildDelegate>;
+
     std::vector<std::unique_ptr<ViewBase>> mChildren;
+    bool mDelegateEvents = false;
+    OnChildClickCallback mOnChildClick;
+    // Declared after mChildren so it is released first
+    std::shared_ptr<const ChildDelegates> mDelegates;
 };
 
 class VStack : public Container<VStack>
 {
 public:
     using Container<VStack>::addChild;
+    using Container<VStack>::padding;
 
 public:
     VStack(const std::string& name = "") : Container<VStack>(name) {}
@@ -83,7 +174,7 @@ public:
     
     VStack& spacing(int space) & 
     {
-        mSpacing = space;
+        mLayout.spacing = space;
         return lself();
     }
     VStack&& spacing(int space) && 
@@ -93,7 +184,7 @@ public:
 
     VStack& alignment(style::Layout::Horizontal align) & 
     {
-        mHorizontalAlign = align;
+        mLayout.crossAlign = style::Layout::toAlignment(align);
         return lself();
     }
     
@@ -102,39 +193,31 @@ public:
         return std::move(static_cast<VStack&>(*this).alignment(align));
     }
 
-protected:
-    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    VStack& padding(int padding) & 
+    {
+        mLayout.padding = padding;
+        return lself();
+    }
+    VStack&& padding(int padding) && 
     {
-        return adaptor::_lvCreateVStack(parent);
+        return std::move(static_cast<VStack&>(*this).padding(padding));
     }
 
-    lv_obj_t* _build(lv_obj_t* parent) override
+protected:
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
     {
-        mLvObj = _createLvObj(parent);
-        if (mLvObj) {
-            if (mSpacing > 0) {
-                // adaptor::_lvSetStyleGap(mLvObj, mSpacing, LV_FLEX_FLOW_COLUMN);
-            }
-            if (mHorizontalAlign != style::Layout::Horizontal::Leading) {
-                // adaptor::_lvSetFlexAlignment(mLvObj, mHorizontalAlign);
-            }
-            this->_applyAllModifiers(mLvObj);
-            for (auto& child : mChildren) {
-                child->_build(mLvObj);
-            }
-        }
-        return mLvObj;
+        return adaptor::_lvCreateStack(parent, mLayout);
     }
 
 private:
-    int mSpacing = 0;
-    style::Layout::Horizontal mHorizontalAlign = style::Layout::Horizontal::Leading;
+    style::StackLayout mLayout{style::Layout::Axis::Vertical};
 };  
 
 class HStack : public Container<HStack>
 {
 public:
     using Container<HStack>::addChild;
+    using Container<HStack>::padding;
 
 public:
     HStack(const std::string& name = "") : Container<HStack>(name) {}
@@ -147,7 +230,7 @@ public:
     
     HStack& spacing(int space) & 
     {
-        mSpacing = space;
+        mLayout.spacing = space;
         return lself();
     }
     HStack&& spacing(int space) && 
@@ -155,43 +238,34 @@ public:
         return std::move(static_cast<HStack&>(*this).spacing(space));
     }
 
-    HStack& alignment(style::Layout::Horizontal align) & 
+    HStack& alignment(style::Layout::Vertical align) & 
     {
-        mHorizontalAlign = align;
+        mLayout.crossAlign = style::Layout::toAlignment(align);
         return lself();
     } 
-    HStack&& alignment(style::Layout::Horizontal align) && 
+    HStack&& alignment(style::Layout::Vertical align) && 
     {
         return std::move(static_cast<HStack&>(*this).alignment(align));
     }
 
-protected:
-    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    HStack& padding(int padding) & 
+    {
+        mLayout.padding = padding;
+        return lself();
+    }
+    HStack&& padding(int padding) && 
     {
-        return adaptor::_lvCreateHStack(parent);
+        return std::move(static_cast<HStack&>(*this).padding(padding));
     }
 
-    lv_obj_t* _build(lv_obj_t* parent) override
+protected:
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
     {
-        mLvObj = _createLvObj(parent);
-        if (mLvObj) {
-            if (mSpacing > 0) {
-                // adaptor::_lvSetStyleGap(mLvObj, mSpacing, LV_FLEX_FLOW_ROW);
-            }
-            if (mHorizontalAlign != style::Layout::Horizontal::Leading) {
-                // adaptor::_lvSetFlexAlignment(mLvObj, mHorizontalAlign);
-            }
-            this->_applyAllModifiers(mLvObj);
-            for (auto& child : mChildren) {
-                child->_build(mLvObj);
-            }
-        }
-        return mLvObj;
+        return adaptor::_lvCreateStack(parent, mLayout);
     }
 
 private:
-    int mSpacing = 0;
-    style::Layout::Horizontal mHorizontalAlign = style::Layout::Horizontal::Leading;
+    style::StackLayout mLayout{style::Layout::Axis::Horizontal};
 };
 
 class ZStack : public Container<ZStack>
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../Executor.h"
+#include "../Render.h"
+#include "../Text.h"
+#include "../View.h"
+
+#include <utility>
+
+namespace gui {
+
+/**
+ * @brief Image loaded from a file, decoded off the UI thread
+ *
+ * An image from a mounted asset pack or the image cache is shown while the view is built. Otherwise the file
+ * is decoded on a worker and the result is committed on the UI thread, the object stays empty until then.
+ * Changing the source again before the decode finishes discards the older result.
+ */
+class Image : public View<Image>
+{
+public:
+    Image() = default;
+    explicit Image(Text path) : View<Image>(), mSource(std::move(path)) {}
+
+    ViewType type() const override { return ViewType::Image; }
+
+    /**
+     * @brief Set the image file, LVGL's binary image format or PNG if LVGL supports it
+     */
+    Image& source(Text path) &
+    {
+        _updateProperty([&] { return mSource.set(std::move(path)); });
+        return lself();
+    }
+    Image&& source(Text path) &&
+    {
+        return std::move(static_cast<Image&>(*this).source(std::move(path)));
+    }
+
+protected:
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateImage(parent);
+    }
+
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<Image>::_applyProperties(obj, force);
+        if (mSource.consume(force) && !mSource.get().empty()) {
+            _load(obj, mSource.get());
+        }
+    }
+
+    static void _load(lv_obj_t* obj, const Text& path)
+    {
+        if (adaptor::_lvShowPackedImage(obj, path.c_str()) || adaptor::_lvShowCachedImage(obj, path.c_str())) {
+            return;
+        }
+
+        adaptor::ImageTicket ticket = adaptor::_lvBeginImageLoad(obj);
+        // Keyed by object, a newer source of the same image waits behind the older one and supersedes it
+        Executor::instance().post(obj, [ticket, path]() {
+            adaptor::ImageRef image = adaptor::_lvDecodeImage(path.c_str());
+            Render::instance().post(nullptr, [ticket, path, image](lv_obj_t*) {
+                adaptor::_lvFinishImageLoad(ticket, path.c_str(), image);
+            });
+        });
+    }
+
+private:
+    Property<Text> mSource;
+};
+
+} // namespace gui
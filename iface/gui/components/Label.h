@@ -1,8 +1,7 @@
 #pragma once
 
 #include "../View.h"
-
-#include <string>
+#include "../Text.h"
 
 namespace gui {
 
@@ -10,15 +9,14 @@ class Label : public View<Label>
 {
 public:
     Label() : View<Label>() {}
-    explicit Label(std::string text) : View<Label>(), mText(std::move(text)) {}
+    explicit Label(Text text) : View<Label>(), mText(std::move(text)) {}
 
-    Label& text(std::string text) &
+    Label& text(Text text) &
     {
-        mText = text;
-        custom([text](lv_obj_t* obj){ adaptor::_lvSetText(obj, text.c_str()); });
+        _updateProperty([&] { return mText.set(std::move(text)); });
         return lself();
     }
-    Label&& text(std::string text) &&
+    Label&& text(Text text) &&
     {
         return std::move(static_cast<Label&>(*this).text(std::move(text)));
     }
@@ -26,6 +24,18 @@ public:
     ViewType type() const override { return ViewType::Label; }
 
 protected:
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<Label>::_applyProperties(obj, force);
+        if (mText.consume(force)) {
+            if (mText.get().isStatic()) {
+                adaptor::_lvSetTextStatic(obj, mText.get().c_str());
+            } else {
+                adaptor::_lvSetText(obj, mText.get().c_str());
+            }
+        }
+    }
+
     virtual lv_obj_t* _createLvObj(lv_obj_t* parent) override
     {
         return adaptor::_lvCreateLabel(parent);
@@ -35,16 +45,14 @@ protected:
     {
         mLvObj = _createLvObj(parent);
         if (mLvObj) {
-            if (!mText.empty()) {
-                adaptor::_lvSetText(mLvObj, mText.c_str());
-            }
+            _applyBuildProperties(mLvObj);
             this->_applyAllModifiers(mLvObj);
         }
         return mLvObj;
     }
 
 private:
-    std::string mText;
+    Property<Text> mText;
 };
 
-} // namespace gui
\ No newline at end of file
+} // namespace gui
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "../View.h"
+#include "../Text.h"
+
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gui {
+
+/**
+ * @brief Scrollable list of text items
+ *
+ * Items are inserted in bulk and edited incrementally, the LVGL list is never rebuilt. A click reports the
+ * item index stored on the clicked row, so the lookup does not depend on the number of items.
+ */
+class List : public View<List>
+{
+public:
+    using OnItemSelectedCallback = std::function<void(size_t index, const std::string& text)>;
+
+public:
+    List() : View<List>() {}
+
+    ViewType type() const override { return ViewType::List; }
+
+    /**
+     * @brief Replace all items
+     * @param[in] texts Texts of the new items
+     * @param[in] count Number of items
+     */
+    List& items(const Text* texts, size_t count) &
+    {
+        _updateProperty([&] {
+            mItems.assign(texts, texts + count);
+            mOps.clear();
+            if (mLvObj) {
+                mOps.push_back(Op{Op::Kind::Clear, 0, {}});
+                _appendOp(mItems.data(), mItems.size());
+            }
+            return true;
+        });
+        return lself();
+    }
+    List&& items(const Text* texts, size_t count) &&
+    {
+        return std::move(static_cast<List&>(*this).items(texts, count));
+    }
+
+    /**
+     * @brief Replace all items with the contents of a contiguous range, e.g. std::vector<Text> or std::array
+     */
+    template <typename Range>
+    List& items(const Range& range) &
+    {
+        return items(std::data(range), std::size(range));
+    }
+    template <typename Range>
+    List&& items(const Range& range) &&
+    {
+        return std::move(static_cast<List&>(*this).items(std::data(range), std::size(range)));
+    }
+
+    List& append(Text text) &
+    {
+        _updateProperty([&] {
+            mItems.push_back(std::move(text));
+            if (mLvObj) {
+                _appendOp(&mItems.back(), 1);
+            }
+            return true;
+        });
+        return lself();
+    }
+    List&& append(Text text) &&
+    {
+        return std::move(static_cast<List&>(*this).append(std::move(text)));
+    }
+
+    List& remove(size_t index) &
+    {
+        _updateProperty([&] {
+            if (index >= mItems.size()) {
+                return false;
+            }
+            mItems.erase(mItems.begin() + static_cast<std::ptrdiff_t>(index));
+            if (mLvObj) {
+                mOps.push_back(Op{Op::Kind::Remove, index, {}});
+            }
+            return true;
+        });
+        return lself();
+    }
+    List&& remove(size_t index) &&
+    {
+        return std::move(static_cast<List&>(*this).remove(index));
+    }
+
+    List& clear() &
+    {
+        return items(static_cast<const Text*>(nullptr), 0);
+    }
+    List&& clear() &&
+    {
+        return std::move(static_cast<List&>(*this).clear());
+    }
+
+    List& onItemSelected(OnItemSelectedCallback callback) &
+    {
+        mOnItemSelected = std::move(callback);
+        return lself();
+    }
+    List&& onItemSelected(OnItemSelectedCallback callback) &&
+    {
+        return std::move(static_cast<List&>(*this).onItemSelected(std::move(callback)));
+    }
+
+    size_t size() const { return mItems.size(); }
+    const Text& item(size_t index) const { return mItems[index]; }
+
+protected:
+    // LVGL edits since the last flush in the order they were made, only recorded once the list is built.
+    // Consecutive appends are merged into one bulk insert.
+    struct Op
+    {
+        enum class Kind {
+            Append,
+            Remove,
+            Clear
+        };
+
+        Kind kind;
+        size_t index;
+        std::vector<Text> texts;
+    };
+
+    void _appendOp(const Text* texts, size_t count)
+    {
+        if (count == 0) {
+            return;
+        }
+        if (mOps.empty() || mOps.back().kind != Op::Kind::Append) {
+            mOps.push_back(Op{Op::Kind::Append, 0, {}});
+        }
+        mOps.back().texts.insert(mOps.back().texts.end(), texts, texts + count);
+    }
+
+    static void _addItems(lv_obj_t* obj, const std::vector<Text>& texts)
+    {
+        std::vector<const char*> strings;
+        strings.reserve(texts.size());
+        for (const auto& text : texts) {
+            strings.push_back(text.c_str());
+        }
+        adaptor::_lvAddListItems(obj, strings.data(), strings.size());
+    }
+
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<List>::_applyProperties(obj, force);
+        if (force) {
+            // Freshly created list, the model already contains every edit
+            mOps.clear();
+            _addItems(obj, mItems);
+            return;
+        }
+
+        for (const auto& op : mOps) {
+            switch (op.kind) {
+                case Op::Kind::Append:
+                    _addItems(obj, op.texts);
+                    break;
+                case Op::Kind::Remove:
+                    adaptor::_lvRemoveListItem(obj, op.index);
+                    break;
+                case Op::Kind::Clear:
+                    adaptor::_lvClearListItems(obj);
+                    break;
+            }
+        }
+        mOps.clear();
+    }
+
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateList(parent);
+    }
+
+    lv_obj_t* _build(lv_obj_t* parent) override
+    {
+        mLvObj = _createLvObj(parent);
+        if (mLvObj) {
+            _applyBuildProperties(mLvObj);
+            this->_applyAllModifiers(mLvObj);
+            if (mOnItemSelected) {
+                adaptor::_lvSetListOnItemSelected(mLvObj,
+                    [callback = mOnItemSelected](int index, const std::string& text) {
+                        callback(static_cast<size_t>(index), text);
+                    });
+            }
+        }
+        return mLvObj;
+    }
+
+private:
+    std::vector<Text> mItems;
+    std::vector<Op> mOps;
+    OnItemSelectedCallback mOnItemSelected;
+};
+
+} // namespace gui
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "../View.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gui {
+
+/**
+ * @brief Scrolling log of text lines, e.g. the firmware console
+ *
+ * Lines go into a ring of fixed capacity, the oldest line is dropped when it is full. Lines appended from any
+ * thread are collected and reach LVGL once per frame. Only the rows in view are rendered, appending does not
+ * lay out the other lines again.
+ *
+ * @note With 16 bit LVGL coordinates the scrollable height ends at LV_COORD_MAX (about 500 lines of a 16 px
+ *       font). A larger capacity keeps the lines but only the newest ones that fit can be scrolled to, enable
+ *       LV_USE_LARGE_COORD to reach all of them.
+ */
+class LogView : public View<LogView>
+{
+public:
+    static constexpr size_t kDefaultCapacity = 500;
+
+    struct Stats
+    {
+        uint64_t appended = 0;
+        uint64_t dropped = 0;       ///< Lines that left the ring, including ones never shown
+        uint32_t batches = 0;       ///< Updates pushed to LVGL
+        uint32_t maxBatch = 0;      ///< Most lines in one update
+    };
+
+public:
+    LogView() : View<LogView>(), mRing(std::make_shared<Ring>(kDefaultCapacity)) {}
+
+    ViewType type() const override { return ViewType::LogView; }
+
+    /**
+     * @brief Set the number of lines kept, the newest lines stay
+     */
+    LogView& capacity(size_t lines) &
+    {
+        _updateProperty([&] {
+            mCapacity = std::max<size_t>(lines, 1);
+            return true;
+        });
+        return lself();
+    }
+    LogView&& capacity(size_t lines) &&
+    {
+        return std::move(static_cast<LogView&>(*this).capacity(lines));
+    }
+
+    /**
+     * @brief Follow new lines while the view is scrolled to the bottom
+     */
+    LogView& autoScroll(bool isEnabled) &
+    {
+        _updateProperty([&] { return mAutoScroll.set(isEnabled); });
+        return lself();
+    }
+    LogView&& autoScroll(bool isEnabled) &&
+    {
+        return std::move(static_cast<LogView&>(*this).autoScroll(isEnabled));
+    }
+
+    /**
+     * @brief Append a line, thread-safe
+     */
+    LogView& appendLine(std::string_view line) &
+    {
+        _updateProperty([&] {
+            mPending.emplace_back(line);
+            ++mStats.appended;
+            // Lines beyond the capacity would be dropped right away, do not keep them around
+            if (mPending.size() >= 2 * mCapacity) {
+                size_t excess = mPending.size() - mCapacity;
+                mPending.erase(mPending.begin(), mPending.begin() + static_cast<std::ptrdiff_t>(excess));
+                mPendingDropped += excess;
+            }
+            return true;
+        });
+        return lself();
+    }
+    LogView&& appendLine(std::string_view line) &&
+    {
+        return std::move(static_cast<LogView&>(*this).appendLine(line));
+    }
+
+    LogView& clear() &
+    {
+        _updateProperty([&] {
+            mPendingDropped += mPending.size();
+            mPending.clear();
+            mClear = true;
+            return true;
+        });
+        return lself();
+    }
+    LogView&& clear() &&
+    {
+        return std::move(static_cast<LogView&>(*this).clear());
+    }
+
+    Stats stats() const
+    {
+        std::lock_guard<std::recursive_mutex> lock(_propertyMutex());
+        return mStats;
+    }
+
+    /**
+     * @brief Counters of the row rendering, available once built, call on the UI thread
+     */
+    adaptor::LogViewStats renderStats() const
+    {
+        return mLvObj ? adaptor::_lvGetLogViewStats(mLvObj) : adaptor::LogViewStats{};
+    }
+
+protected:
+    /**
+     * @brief Lines in view of LVGL, only changed on the UI thread while applying the properties
+     */
+    class Ring
+    {
+    public:
+        explicit Ring(size_t capacity) : mSlots(capacity) {}
+
+        size_t size() const { return mCount; }
+        const std::string& at(size_t index) const { return mSlots[(mFirst + index) % mSlots.size()]; }
+
+        /**
+         * @return Number of lines dropped from the front
+         */
+        size_t push(std::string&& line)
+        {
+            if (mCount < mSlots.size()) {
+                mSlots[(mFirst + mCount++) % mSlots.size()] = std::move(line);
+                return 0;
+            }
+            mSlots[mFirst] = std::move(line);
+            mFirst = (mFirst + 1) % mSlots.size();
+            return 1;
+        }
+
+        size_t clear()
+        {
+            size_t dropped = mCount;
+            mFirst = 0;
+            mCount = 0;
+            return dropped;
+        }
+
+        /**
+         * @return Number of lines dropped from the front
+         */
+        size_t resize(size_t capacity)
+        {
+            if (capacity == mSlots.size()) {
+                return 0;
+            }
+            size_t dropped = mCount > capacity ? mCount - capacity : 0;
+            std::vector<std::string> slots(capacity);
+            for (size_t i = dropped; i < mCount; ++i) {
+                slots[i - dropped] = std::move(mSlots[(mFirst + i) % mSlots.size()]);
+            }
+            mSlots.swap(slots);
+            mFirst = 0;
+            mCount -= dropped;
+            return dropped;
+        }
+
+    private:
+        std::vector<std::string> mSlots;
+        size_t mFirst = 0;
+        size_t mCount = 0;
+    };
+
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<LogView>::_applyProperties(obj, force);
+        if (mAutoScroll.consume(force)) {
+            adaptor::_lvSetLogViewAutoScroll(obj, mAutoScroll.get());
+        }
+
+        size_t dropped = mRing->resize(mCapacity) + mPendingDropped;
+        if (mClear) {
+            dropped += mRing->clear();
+            mClear = false;
+        }
+        size_t batch = mPending.size();
+        for (std::string& line : mPending) {
+            dropped += mRing->push(std::move(line));
+        }
+        mPending.clear();
+        mPendingDropped = 0;
+
+        if (batch == 0 && dropped == 0 && !force) {
+            return;
+        }
+        mStats.dropped += dropped;
+        ++mStats.batches;
+        mStats.maxBatch = std::max(mStats.maxBatch, static_cast<uint32_t>(batch));
+        // A new object has no lines yet, nothing to move up
+        adaptor::_lvUpdateLogView(obj, mRing->size(), force ? 0 : dropped);
+    }
+
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateLogView(parent);
+    }
+
+    lv_obj_t* _build(lv_obj_t* parent) override
+    {
+        mLvObj = _createLvObj(parent);
+        if (mLvObj) {
+            // The ring outlives a move of the view, the LVGL object keeps reading from it
+            adaptor::_lvSetLogViewSource(mLvObj, [ring = mRing](size_t index) { return ring->at(index).c_str(); });
+            _applyBuildProperties(mLvObj);
+            this->_applyAllModifiers(mLvObj);
+        }
+        return mLvObj;
+    }
+
+private:
+    std::shared_ptr<Ring> mRing;
+    size_t mCapacity = kDefaultCapacity;
+    std::vector<std::string> mPending;
+    size_t mPendingDropped = 0;
+    bool mClear = false;
+    Property<bool> mAutoScroll{true};
+    Stats mStats;
+};
+
+} // namespace gui
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "../View.h"
+#include "../Text.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace gui {
+
+/**
+ * @brief Label showing a number with a fixed count of decimals and an optional unit, e.g. "212.5 °C"
+ *
+ * The text is formatted into an inline buffer and only pushed to LVGL when the rendered characters
+ * change, so frequent telemetry updates neither allocate nor redraw needlessly.
+ */
+template <int Precision = 0>
+class NumericLabel : public View<NumericLabel<Precision>>
+{
+    static_assert(Precision >= 0 && Precision <= 6, "NumericLabel supports 0 to 6 decimals");
+
+public:
+    static constexpr size_t kCapacity = 48;
+
+    struct Buffer
+    {
+        std::array<char, kCapacity> data{};
+        uint8_t size = 0;
+
+        const char* c_str() const { return data.data(); }
+
+        bool operator==(const Buffer& o) const
+        {
+            return size == o.size && std::memcmp(data.data(), o.data.data(), size) == 0;
+        }
+    };
+
+public:
+    NumericLabel() = default;
+    explicit NumericLabel(double value) { this->value(value); }
+
+    ViewType type() const override { return ViewType::NumericLabel; }
+
+    NumericLabel& value(double value) &
+    {
+        this->_updateProperty([&] {
+            mValue = value;
+            return mRendered.set(format(value, mUnit));
+        });
+        return *this;
+    }
+    NumericLabel&& value(double value) &&
+    {
+        return std::move(static_cast<NumericLabel&>(*this).value(value));
+    }
+
+    /**
+     * @brief Set the text appended after the number, e.g. "%" or " °C"
+     */
+    NumericLabel& unit(Text unit) &
+    {
+        this->_updateProperty([&] {
+            mUnit = std::move(unit);
+            return mRendered.set(format(mValue, mUnit));
+        });
+        return *this;
+    }
+    NumericLabel&& unit(Text unit) &&
+    {
+        return std::move(static_cast<NumericLabel&>(*this).unit(std::move(unit)));
+    }
+
+    /**
+     * @brief Format a value the way the label renders it
+     * @param[in] value Number to format, non-finite or out of range values render as "--"
+     * @param[in] unit Suffix appended after the number, truncated to the buffer capacity
+     * @return NUL terminated text in an inline buffer
+     */
+    static Buffer format(double value, const Text& unit)
+    {
+        constexpr int64_t kScale = _pow10(Precision);
+        constexpr double kLimit = 9.0e15 / kScale;
+
+        Buffer buf;
+        char* it = buf.data.data();
+        char* end = buf.data.data() + kCapacity - 1;
+
+        if (!std::isfinite(value) || std::fabs(value) >= kLimit) {
+            *it++ = '-';
+            *it++ = '-';
+        } else {
+            int64_t fixed = std::llround(value * kScale);
+            if (fixed < 0) {
+                *it++ = '-';
+                fixed = -fixed;
+            }
+            it = std::to_chars(it, end, fixed / kScale).ptr;
+            if constexpr (Precision > 0) {
+                int64_t fraction = fixed % kScale;
+                *it++ = '.';
+                for (int i = Precision - 1; i >= 0; --i) {
+                    it[i] = static_cast<char>('0' + fraction % 10);
+                    fraction /= 10;
+                }
+                it += Precision;
+            }
+        }
+
+        size_t unitSize = std::min(unit.size(), static_cast<size_t>(end - it));
+        std::memcpy(it, unit.c_str(), unitSize);
+        it += unitSize;
+        *it = '\0';
+        buf.size = static_cast<uint8_t>(it - buf.data.data());
+        return buf;
+    }
+
+protected:
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<NumericLabel<Precision>>::_applyProperties(obj, force);
+        if (mRendered.consume(force)) {
+            adaptor::_lvSetText(obj, mRendered.get().c_str());
+        }
+    }
+
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateLabel(parent);
+    }
+
+    lv_obj_t* _build(lv_obj_t* parent) override
+    {
+        this->mLvObj = _createLvObj(parent);
+        if (this->mLvObj) {
+            this->_applyBuildProperties(this->mLvObj);
+            this->_applyAllModifiers(this->mLvObj);
+        }
+        return this->mLvObj;
+    }
+
+private:
+    static constexpr int64_t _pow10(int exp)
+    {
+        int64_t result = 1;
+        for (int i = 0; i < exp; ++i) {
+            result *= 10;
+        }
+        return result;
+    }
+
+private:
+    double mValue = 0.0;
+    Text mUnit;
+    Property<Buffer> mRendered;
+};
+
+} // namespace gui
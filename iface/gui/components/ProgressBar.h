@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Bar.h"
+
+#include <cmath>
+
+namespace gui {
+
+/**
+ * @brief Bar showing the completion of a task, e.g. the print progress
+ *
+ * The range has a fine resolution so slow tasks still move smoothly, changes too small to show are dropped
+ * by the bar update policy.
+ */
+class ProgressBar : public BarView<ProgressBar>
+{
+public:
+    static constexpr int kResolution = 1000;
+
+public:
+    ProgressBar() { this->range(0, kResolution); }
+    explicit ProgressBar(double fraction) : ProgressBar() { progress(fraction); }
+
+    ViewType type() const override { return ViewType::ProgressBar; }
+
+    /**
+     * @brief Set the completion
+     * @param[in] fraction 0.0 to 1.0, values outside are clamped and NaN counts as 0
+     */
+    ProgressBar& progress(double fraction) &
+    {
+        if (!(fraction > 0.0)) {
+            fraction = 0.0;
+        } else if (fraction > 1.0) {
+            fraction = 1.0;
+        }
+        return this->value(static_cast<int>(std::lround(fraction * kResolution)));
+    }
+    ProgressBar&& progress(double fraction) &&
+    {
+        return std::move(static_cast<ProgressBar&>(*this).progress(fraction));
+    }
+
+protected:
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateProgressBar(parent, 0);
+    }
+};
+
+} // namespace gui
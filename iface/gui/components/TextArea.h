@@ -0,0 +1,212 @@
+#pragma once
+
+#include "../View.h"
+#include "../Text.h"
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace gui {
+
+/**
+ * @brief Editable multi-line text
+ *
+ * Edits are reported as deltas, so a long text (e.g. a G-code console) costs nothing per keystroke.
+ *
+ * In log mode lines are only appended, the lines of one frame reach LVGL in one update and the oldest
+ * lines are dropped above the line limit.
+ */
+class TextArea : public View<TextArea>
+{
+public:
+    using OnEditCallback = std::function<void(const adaptor::TextEdit& edit)>;
+
+public:
+    TextArea() : View<TextArea>() {}
+    explicit TextArea(Text text) : View<TextArea>(), mText(std::move(text)) {}
+
+    ViewType type() const override { return ViewType::TextArea; }
+
+    /**
+     * @brief Replace the content, including the logged lines
+     */
+    TextArea& text(Text text) &
+    {
+        _updateProperty([&] {
+            mRewrite = mText.set(std::move(text)) || !mLines.empty() || mRewrite;
+            mLines.clear();
+            mUnflushedLines = 0;
+            mCutLength = 0;
+            return mRewrite;
+        });
+        return lself();
+    }
+    TextArea&& text(Text text) &&
+    {
+        return std::move(static_cast<TextArea&>(*this).text(std::move(text)));
+    }
+
+    TextArea& placeholder(Text text) &
+    {
+        _updateProperty([&] { return mPlaceholder.set(std::move(text)); });
+        return lself();
+    }
+    TextArea&& placeholder(Text text) &&
+    {
+        return std::move(static_cast<TextArea&>(*this).placeholder(std::move(text)));
+    }
+
+    /**
+     * @brief Report every change as an edit of the previous text
+     * @param[in] coalesce Deliver the edits once per frame, consecutive typing or backspacing merges into one
+     */
+    TextArea& onEdit(OnEditCallback callback, bool coalesce = false) &
+    {
+        mOnEdit = std::move(callback);
+        mCoalesceEdits = coalesce;
+        return lself();
+    }
+    TextArea&& onEdit(OnEditCallback callback, bool coalesce = false) &&
+    {
+        return std::move(static_cast<TextArea&>(*this).onEdit(std::move(callback), coalesce));
+    }
+
+    /**
+     * @brief Keep at most maxLines lines appended with appendLine
+     * @param[in] maxLines 0 keeps all lines
+     */
+    TextArea& maxLines(uint32_t maxLines) &
+    {
+        _updateProperty([&] {
+            mMaxLines = maxLines;
+            return _trimLines();
+        });
+        return lself();
+    }
+    TextArea&& maxLines(uint32_t maxLines) &&
+    {
+        return std::move(static_cast<TextArea&>(*this).maxLines(maxLines));
+    }
+
+    /**
+     * @brief Append a line after the text and the lines before
+     */
+    TextArea& appendLine(std::string_view line) &
+    {
+        _updateProperty([&] {
+            mLines.push_back(Line{std::string(line), _length(line) + 1});
+            ++mUnflushedLines;
+            _trimLines();
+            return true;
+        });
+        return lself();
+    }
+    TextArea&& appendLine(std::string_view line) &&
+    {
+        return std::move(static_cast<TextArea&>(*this).appendLine(line));
+    }
+
+    size_t lineCount() const { return mLines.size(); }
+
+protected:
+    void _applyProperties(lv_obj_t* obj, bool force) override
+    {
+        View<TextArea>::_applyProperties(obj, force);
+        if (mPlaceholder.consume(force)) {
+            adaptor::_lvSetTextAreaPlaceholder(obj, mPlaceholder.get().c_str());
+        }
+
+        if (mText.consume(force) || force || mRewrite) {
+            // Rebuilt from scratch, the lines follow the text
+            std::string content = mText.get().c_str();
+            mTextLength = _length(content);
+            for (const Line& line : mLines) {
+                content.append(line.text).push_back('\n');
+            }
+            adaptor::_lvSetTextAreaText(obj, content.c_str());
+            mUnflushedLines = 0;
+            mCutLength = 0;
+            mRewrite = false;
+            return;
+        }
+
+        if (mUnflushedLines == 0 && mCutLength == 0) {
+            return;
+        }
+        std::string appended;
+        for (size_t i = mLines.size() - mUnflushedLines; i < mLines.size(); ++i) {
+            appended.append(mLines[i].text).push_back('\n');
+        }
+        adaptor::_lvAppendTextAreaText(obj, appended.c_str(), mTextLength, mCutLength);
+        mUnflushedLines = 0;
+        mCutLength = 0;
+    }
+
+    lv_obj_t* _createLvObj(lv_obj_t* parent) override
+    {
+        return adaptor::_lvCreateTextArea(parent, nullptr);
+    }
+
+    lv_obj_t* _build(lv_obj_t* parent) override
+    {
+        mLvObj = _createLvObj(parent);
+        if (mLvObj) {
+            _applyBuildProperties(mLvObj);
+            this->_applyAllModifiers(mLvObj);
+            if (mOnEdit) {
+                adaptor::_lvSetTextAreaOnEdit(mLvObj, mOnEdit, mCoalesceEdits);
+            }
+        }
+        return mLvObj;
+    }
+
+private:
+    struct Line
+    {
+        std::string text;
+        uint32_t length;    ///< Characters including the line break
+    };
+
+    static uint32_t _length(std::string_view text)
+    {
+        uint32_t length = 0;
+        for (char c : text) {
+            length += (static_cast<uint8_t>(c) & 0xC0) != 0x80;
+        }
+        return length;
+    }
+
+    bool _trimLines()
+    {
+        bool changed = false;
+        while (mMaxLines > 0 && mLines.size() > mMaxLines) {
+            if (mLines.size() > mUnflushedLines) {
+                // Already shown, cut it with the next update
+                mCutLength += mLines.front().length;
+            } else {
+                --mUnflushedLines;
+            }
+            mLines.pop_front();
+            changed = true;
+        }
+        return changed;
+    }
+
+    Property<Text> mText;
+    Property<Text> mPlaceholder;
+    OnEditCallback mOnEdit;
+    bool mCoalesceEdits = false;
+
+    std::deque<Line> mLines;
+    uint32_t mMaxLines = 0;
+    uint32_t mUnflushedLines = 0;
+    uint32_t mCutLength = 0;
+    uint32_t mTextLength = 0;   ///< Characters of the text before the lines, as shown
+    bool mRewrite = false;
+};
+
+} // namespace gui
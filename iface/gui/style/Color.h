@@ -5,6 +5,9 @@
 namespace gui{
 namespace style {
 
+/**
+ * @brief 0xAARRGGBB, alpha 0xFF is opaque and 0x00 fully transparent
+ */
 struct Color
 {
     uint32_t value;
@@ -38,6 +41,20 @@ struct Color
     static constexpr uint32_t BgBase        = Grey50;
     static constexpr uint32_t BgMiddle      = Grey100; 
     static constexpr uint32_t BgTop         = Grey200; 
+
+    /**
+     * @brief Opaque color from 0xRRGGBB
+     */
+    static constexpr Color rgb(uint32_t rgb) { return Color{0xFF000000 | (rgb & 0x00FFFFFF)}; }
+    constexpr Color withAlpha(uint8_t alpha) const { return Color{(value & 0x00FFFFFF) | (uint32_t(alpha) << 24)}; }
+
+    constexpr uint8_t alpha() const { return static_cast<uint8_t>(value >> 24); }
+    constexpr uint8_t red() const { return static_cast<uint8_t>(value >> 16); }
+    constexpr uint8_t green() const { return static_cast<uint8_t>(value >> 8); }
+    constexpr uint8_t blue() const { return static_cast<uint8_t>(value); }
+
+    constexpr bool operator==(const Color& other) const { return value == other.value; }
+    constexpr bool operator!=(const Color& other) const { return value != other.value; }
 };
 
 } // namespace style
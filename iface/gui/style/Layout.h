@@ -16,7 +16,49 @@ struct Layout
         Center,
         Bottom
     };
+
+    enum class Axis {
+        Vertical,
+        Horizontal
+    };
+
+    enum class Alignment {
+        Start,
+        Center,
+        End
+    };
+
+    static constexpr Alignment toAlignment(Horizontal align)
+    {
+        return align == Horizontal::Leading ? Alignment::Start
+             : align == Horizontal::Center  ? Alignment::Center
+                                            : Alignment::End;
+    }
+
+    static constexpr Alignment toAlignment(Vertical align)
+    {
+        return align == Vertical::Top    ? Alignment::Start
+             : align == Vertical::Center ? Alignment::Center
+                                         : Alignment::End;
+    }
+};
+
+/**
+ * @brief Flex configuration of a stack, the adaptor keeps one shared style per distinct value
+ */
+struct StackLayout
+{
+    Layout::Axis axis = Layout::Axis::Vertical;
+    int spacing = 0;
+    int padding = -1; // negative keeps the theme padding
+    Layout::Alignment crossAlign = Layout::Alignment::Start;
+
+    constexpr bool operator==(const StackLayout& o) const
+    {
+        return axis == o.axis && spacing == o.spacing && padding == o.padding && crossAlign == o.crossAlign;
+    }
+    constexpr bool operator!=(const StackLayout& o) const { return !(*this == o); }
 };
 
 } // namespace style
-} // namespace gui
\ No newline at end of file
+} // namespace gui
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Color.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+struct _lv_font_t;
+typedef _lv_font_t lv_font_t;
+
+namespace gui {
+namespace style {
+
+// ==================== Theme tokens ====================
+// Views refer to a token instead of a value. Every token is one shared LVGL style, switching the theme
+// rewrites these styles and LVGL restyles the objects that use them.
+
+enum class ColorToken : uint8_t {
+    Brand,
+    Primary,
+    Secondary,
+    Info,
+    Warning,
+    Danger,
+    BgBase,
+    BgMiddle,
+    BgTop,
+    TextPrimary,
+    TextSecondary,
+    Count
+};
+
+enum class SpacingToken : uint8_t {
+    None,
+    Small,
+    Medium,
+    Large,
+    Count
+};
+
+enum class RadiusToken : uint8_t {
+    None,
+    Small,
+    Medium,
+    Large,
+    Count
+};
+
+enum class FontToken : uint8_t {
+    Body,
+    Title,
+    Caption,
+    Count
+};
+
+struct Theme
+{
+    std::array<Color, size_t(ColorToken::Count)> colors{};
+    std::array<int16_t, size_t(SpacingToken::Count)> spacing{0, 4, 8, 16};
+    std::array<int16_t, size_t(RadiusToken::Count)> radius{0, 4, 8, 16};
+    std::array<const lv_font_t*, size_t(FontToken::Count)> fonts{};    ///< nullptr keeps LVGL's default font
+
+    Color color(ColorToken token) const { return colors[size_t(token)]; }
+    int16_t space(SpacingToken token) const { return spacing[size_t(token)]; }
+    int16_t corner(RadiusToken token) const { return radius[size_t(token)]; }
+    const lv_font_t* font(FontToken token) const { return fonts[size_t(token)]; }
+
+    Theme& color(ColorToken token, Color value)
+    {
+        colors[size_t(token)] = value;
+        return *this;
+    }
+    Theme& space(SpacingToken token, int16_t value)
+    {
+        spacing[size_t(token)] = value;
+        return *this;
+    }
+    Theme& corner(RadiusToken token, int16_t value)
+    {
+        radius[size_t(token)] = value;
+        return *this;
+    }
+    Theme& font(FontToken token, const lv_font_t* value)
+    {
+        fonts[size_t(token)] = value;
+        return *this;
+    }
+
+    /**
+     * @brief The palette of Color, the theme in effect until another one is set
+     */
+    static Theme dark()
+    {
+        Theme theme;
+        theme.colors = {Color{Color::Brand},  Color{Color::Primary}, Color{Color::Secondary}, Color{Color::Info},
+                        Color{Color::Warning}, Color{Color::Danger}, Color{Color::BgBase},    Color{Color::BgMiddle},
+                        Color{Color::BgTop},   Color{Color::White},  Color{Color::Grey700}};
+        return theme;
+    }
+
+    static Theme light()
+    {
+        Theme theme = dark();
+        theme.color(ColorToken::Primary, Color{Color::White})
+            .color(ColorToken::BgBase, Color{Color::White})
+            .color(ColorToken::BgMiddle, Color{Color::Grey900})
+            .color(ColorToken::BgTop, Color{Color::Grey800})
+            .color(ColorToken::TextPrimary, Color{Color::Black})
+            .color(ColorToken::TextSecondary, Color{Color::Grey400});
+        return theme;
+    }
+};
+
+} // namespace style
+} // namespace gui
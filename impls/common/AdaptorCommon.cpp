@@ -0,0 +1,962 @@
+#include "AdaptorCommon.h"
+#include "EventDispatcher.h"
+#include "Recorder.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+int _lvPreinit()
+{ 
+    // do nothing
+    return 0;
+}
+
+uint64_t steady_us()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+// ==================== Async calls ====================
+// LVGL is not thread-safe and lv_async_call creates a timer, so tasks posted from worker or application
+// threads are queued under a mutex instead and run by one timer on the UI thread.
+
+static std::mutex gAsyncMutex;
+static std::vector<std::function<void()>> gAsyncTasks;
+static std::atomic<bool> gHasAsyncTasks{false};
+static lv_timer_t* gAsyncTimer = nullptr;
+
+static void run_async_calls(lv_timer_t* timer)
+{
+    LV_UNUSED(timer);
+    if (!gHasAsyncTasks.load(std::memory_order_acquire)) return;
+
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(gAsyncMutex);
+        tasks.swap(gAsyncTasks);
+        gHasAsyncTasks.store(false, std::memory_order_relaxed);
+    }
+    // Tasks posted by these run on the next pass, a task that posts itself cannot keep the handler busy
+    for (auto& task : tasks) {
+        try {
+            task();
+        } catch (...) {
+            // TODO: LOG ERROR
+        }
+    }
+}
+
+static void run_next_frame_call(lv_timer_t* timer)
+{
+    auto* task = static_cast<std::function<void()>*>(timer_user_data(timer));
+    try {
+        (*task)();
+    } catch (...) {
+        // TODO: LOG ERROR
+    }
+    delete task;
+}
+
+int _lvInit()
+{
+    lv_init();
+    // 1 ms instead of 0: LVGL restarts the timer list when a task creates a timer, the queue runs once per tick
+    gAsyncTimer = lv_timer_create(run_async_calls, 1, nullptr);
+    return 0;
+}
+
+void _lvDeinit()
+{
+    if (gAsyncTimer) {
+        timer_delete(gAsyncTimer);
+        gAsyncTimer = nullptr;
+    }
+}
+
+void _lvLoop()
+{
+    while (true) {
+        record_call(RecordOp::Loop);
+        lv_timer_handler();
+        usleep(5000);
+    }
+    return;
+}
+
+void _lvAsyncCall(std::function<void()> task)
+{
+    std::lock_guard<std::mutex> lock(gAsyncMutex);
+    gAsyncTasks.push_back(std::move(task));
+    gHasAsyncTasks.store(true, std::memory_order_release);
+}
+
+void _lvCallNextFrame(std::function<void()> task)
+{
+    // One-shot timer, LVGL deletes it after the call
+    lv_timer_t* timer = lv_timer_create(run_next_frame_call, refresh_period(),
+                                        new std::function<void()>(std::move(task)));
+    lv_timer_set_repeat_count(timer, 1);
+}
+
+// ==================== Build scope ====================
+// While a view tree is built the first object created (the subtree root) stays hidden, so children
+// creation and style setup neither invalidate the screen nor get laid out one by one. The layout is
+// updated once and the root revealed when the outermost scope ends.
+
+struct BuildScope
+{
+    int depth = 0;
+    lv_obj_t* root = nullptr;
+    bool hidRoot = false;       ///< The root was visible and hidden by the scope, which has to reveal it
+    uint32_t objects = 0;
+    std::chrono::steady_clock::time_point start;
+};
+
+static BuildScope gBuildScope;
+static BuildStats gBuildStats;
+
+lv_obj_t* track_created(lv_obj_t* obj)
+{
+    if (gBuildScope.depth == 0 || !obj) {
+        return obj;
+    }
+
+    ++gBuildScope.objects;
+    if (!gBuildScope.root) {
+        gBuildScope.root = obj;
+        gBuildScope.hidRoot = !lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+    return obj;
+}
+
+void _lvBeginBuild()
+{
+    record_call(RecordOp::BeginBuild);
+    if (gBuildScope.depth++ == 0) {
+        gBuildScope.start = std::chrono::steady_clock::now();
+    }
+}
+
+void _lvEndBuild()
+{
+    record_call(RecordOp::EndBuild);
+    if (gBuildScope.depth == 0 || --gBuildScope.depth > 0) {
+        return;
+    }
+
+    auto layoutStart = std::chrono::steady_clock::now();
+    if (gBuildScope.root) {
+        // Revealing the root invalidates it once, then the whole subtree is laid out in one pass. A root that
+        // was hidden before the scope hid it stays hidden
+        if (gBuildScope.hidRoot) {
+            obj_remove_flag(gBuildScope.root, LV_OBJ_FLAG_HIDDEN);
+        }
+        lv_obj_update_layout(gBuildScope.root);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    auto us = [](auto duration) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+
+    ++gBuildStats.builds;
+    gBuildStats.lastObjects = gBuildScope.objects;
+    gBuildStats.totalObjects += gBuildScope.objects;
+    gBuildStats.lastBuildUs = us(end - gBuildScope.start);
+    gBuildStats.lastLayoutUs = us(end - layoutStart);
+    gBuildStats.totalBuildUs += gBuildStats.lastBuildUs;
+    gBuildScope = BuildScope{};
+}
+
+BuildStats _lvGetBuildStats()
+{
+    return gBuildStats;
+}
+
+lv_obj_t* _lvCreateObj(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateObj, track_created(lv_obj_create(parent)), parent);
+}
+
+void _lvDestroyObj(lv_obj_t* obj)
+{
+    record_destroyed(obj);
+    obj_delete(obj);
+}
+
+// ==================== Redraw profiler ====================
+// The backend reports invalidated and flushed areas and the end of each refresh, the areas are counted per
+// redraw tag. The invalidations of one refresh make one frame.
+
+static constexpr const char* kUntaggedRedraw = "(lvgl)";
+
+struct RedrawProfiler
+{
+    struct Stat
+    {
+        uint64_t invalidations = 0;
+        uint64_t pixels = 0;
+        uint32_t frames = 0;
+        uint32_t lastFrame = UINT32_MAX;
+    };
+
+    bool frameDirty = false;
+    const char* tag = nullptr;
+
+    uint32_t frames = 0;
+    uint64_t invalidatedPixels = 0;
+    uint64_t flushedPixels = 0;
+    std::map<std::string, Stat, std::less<>> stats;
+};
+
+static RedrawProfiler gRedraw;
+
+void redraw_invalidated(const lv_area_t* area)
+{
+    std::string_view name = gRedraw.tag ? gRedraw.tag : kUntaggedRedraw;
+    auto it = gRedraw.stats.find(name);
+    if (it == gRedraw.stats.end()) {
+        it = gRedraw.stats.emplace(std::string(name), RedrawProfiler::Stat{}).first;
+    }
+
+    uint32_t pixels = lv_area_get_size(area);
+    RedrawProfiler::Stat& stat = it->second;
+    ++stat.invalidations;
+    stat.pixels += pixels;
+    if (stat.lastFrame != gRedraw.frames) {
+        stat.lastFrame = gRedraw.frames;
+        ++stat.frames;
+    }
+    gRedraw.invalidatedPixels += pixels;
+    gRedraw.frameDirty = true;
+}
+
+void redraw_flushed(const lv_area_t* area)
+{
+    gRedraw.flushedPixels += lv_area_get_size(area);
+}
+
+void redraw_refreshed()
+{
+    if (gRedraw.frameDirty) {
+        gRedraw.frameDirty = false;
+        ++gRedraw.frames;
+    }
+}
+
+const char* _lvSetRedrawTag(const char* name)
+{
+    const char* previous = gRedraw.tag;
+    gRedraw.tag = name;
+    return previous;
+}
+
+RedrawReport _lvGetRedrawReport(size_t topN)
+{
+    RedrawReport report;
+    report.frames = gRedraw.frames;
+    report.invalidatedPixels = gRedraw.invalidatedPixels;
+    report.flushedPixels = gRedraw.flushedPixels;
+
+    report.top.reserve(gRedraw.stats.size());
+    for (const auto& [name, stat] : gRedraw.stats) {
+        report.top.push_back(RedrawStat{name, stat.invalidations, stat.pixels, stat.frames});
+    }
+
+    auto byPixels = [](const RedrawStat& a, const RedrawStat& b) { return a.pixels > b.pixels; };
+    topN = std::min(topN, report.top.size());
+    std::partial_sort(report.top.begin(), report.top.begin() + static_cast<std::ptrdiff_t>(topN), report.top.end(),
+                      byPixels);
+    report.top.resize(topN);
+    return report;
+}
+
+void _lvResetRedrawProfiler()
+{
+    gRedraw.frames = 0;
+    gRedraw.invalidatedPixels = 0;
+    gRedraw.flushedPixels = 0;
+    gRedraw.frameDirty = false;
+    gRedraw.stats.clear();
+}
+
+// ==================== Shared layout styles ====================
+// Stacks get their size, flex flow, gap, padding and alignment from one shared style per distinct
+// configuration, so creating a stack costs a single lv_obj_add_style instead of a series of local
+// style writes that each refresh the style and invalidate the layout.
+
+static lv_flex_align_t to_flex_align(gui::style::Layout::Alignment align)
+{
+    switch (align) {
+        case gui::style::Layout::Alignment::Center:
+            return LV_FLEX_ALIGN_CENTER;
+        case gui::style::Layout::Alignment::End:
+            return LV_FLEX_ALIGN_END;
+        case gui::style::Layout::Alignment::Start:
+        default:
+            return LV_FLEX_ALIGN_START;
+    }
+}
+
+struct StackStyle
+{
+    gui::style::StackLayout layout;
+    lv_style_t style;
+};
+
+static lv_style_t* stack_style(const gui::style::StackLayout& layout)
+{
+    // std::list keeps the styles at stable addresses, objects reference them until they are deleted
+    static std::list<StackStyle> sStyles;
+
+    for (auto& entry : sStyles) {
+        if (entry.layout == layout) {
+            return &entry.style;
+        }
+    }
+
+    auto& entry = sStyles.emplace_back();
+    entry.layout = layout;
+    lv_style_t* style = &entry.style;
+    lv_style_init(style);
+    lv_style_set_width(style, LV_SIZE_CONTENT);
+    lv_style_set_height(style, LV_SIZE_CONTENT);
+    lv_style_set_layout(style, LV_LAYOUT_FLEX);
+    if (layout.axis == gui::style::Layout::Axis::Vertical) {
+        lv_style_set_flex_flow(style, LV_FLEX_FLOW_COLUMN);
+        lv_style_set_pad_row(style, layout.spacing);
+    } else {
+        lv_style_set_flex_flow(style, LV_FLEX_FLOW_ROW);
+        lv_style_set_pad_column(style, layout.spacing);
+    }
+    lv_style_set_flex_cross_place(style, to_flex_align(layout.crossAlign));
+    lv_style_set_flex_track_place(style, to_flex_align(layout.crossAlign));
+    if (layout.padding >= 0) {
+        lv_style_set_pad_all(style, layout.padding);
+    }
+    return style;
+}
+
+static lv_style_t* content_size_style()
+{
+    static lv_style_t* sStyle = [] {
+        static lv_style_t style;
+        lv_style_init(&style);
+        lv_style_set_width(&style, LV_SIZE_CONTENT);
+        lv_style_set_height(&style, LV_SIZE_CONTENT);
+        return &style;
+    }();
+    return sStyle;
+}
+
+void _lvSetFlexAlignment(lv_obj_t* obj, gui::style::Layout::Horizontal align)
+{
+    record_call(RecordOp::SetFlexHorizontal, obj, align);
+    lv_flex_align_t lv_align;
+    switch (align) {
+        case gui::style::Layout::Horizontal::Leading: {
+            lv_align = LV_FLEX_ALIGN_START;
+        }
+        break;
+        case gui::style::Layout::Horizontal::Center: {
+            lv_align = LV_FLEX_ALIGN_CENTER;
+        }
+        break;
+        case gui::style::Layout::Horizontal::Trailing: {
+            lv_align = LV_FLEX_ALIGN_END;
+        }
+        break;
+    }
+    lv_obj_set_style_flex_cross_place(obj, lv_align, LV_PART_MAIN);
+}
+
+void _lvSetFlexAlignment(lv_obj_t* obj, gui::style::Layout::Vertical align)
+{
+    record_call(RecordOp::SetFlexVertical, obj, align);
+    lv_flex_align_t lv_align;
+    switch (align) {
+        case gui::style::Layout::Vertical::Top: {
+            lv_align = LV_FLEX_ALIGN_START;
+        }
+        break;
+        case gui::style::Layout::Vertical::Center: {
+            lv_align = LV_FLEX_ALIGN_CENTER;
+        }
+        break;
+        case gui::style::Layout::Vertical::Bottom: {
+            lv_align = LV_FLEX_ALIGN_END;
+        }
+        break;
+    }
+    lv_obj_set_style_flex_cross_place(obj, lv_align, LV_PART_MAIN);
+}
+
+lv_obj_t* _lvCreateStack(lv_obj_t* parent, const gui::style::StackLayout& layout)
+{
+    lv_obj_t* cont = track_created(lv_obj_create(parent));
+    lv_obj_add_style(cont, stack_style(layout), LV_PART_MAIN);
+    return record_created(RecordOp::CreateStack, cont, parent, layout);
+}
+
+lv_obj_t* _lvCreateVStack(lv_obj_t* parent)
+{
+    return _lvCreateStack(parent, gui::style::StackLayout{gui::style::Layout::Axis::Vertical});
+}
+
+lv_obj_t* _lvCreateHStack(lv_obj_t* parent)
+{
+    return _lvCreateStack(parent, gui::style::StackLayout{gui::style::Layout::Axis::Horizontal});
+}
+
+lv_obj_t* _lvCreateZStack(lv_obj_t* parent)
+{
+    lv_obj_t* cont = track_created(lv_obj_create(parent));
+    lv_obj_add_style(cont, content_size_style(), LV_PART_MAIN);
+    return record_created(RecordOp::CreateZStack, cont, parent);
+}
+
+// ==================== Text measurement cache ====================
+// Labels cycle through a small set of values (telemetry, states), so text measured by the adaptor is memoised
+// per font/text/width. lv_label measures its own text in lv_label_refr_text and for the layout, which the public
+// API has no hook for; labels only skip setting a text they already show.
+
+struct TextSizeKey
+{
+    const lv_font_t* font;
+    uint64_t textHash;
+    coord_t maxWidth;
+    coord_t letterSpace;
+    coord_t lineSpace;
+
+    bool operator==(const TextSizeKey& o) const
+    {
+        return font == o.font && textHash == o.textHash && maxWidth == o.maxWidth &&
+               letterSpace == o.letterSpace && lineSpace == o.lineSpace;
+    }
+};
+
+struct TextSizeKeyHash
+{
+    size_t operator()(const TextSizeKey& key) const
+    {
+        uint64_t h = key.textHash;
+        h ^= reinterpret_cast<uintptr_t>(key.font) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h ^= (static_cast<uint64_t>(static_cast<uint16_t>(key.maxWidth)) << 32) |
+             (static_cast<uint64_t>(static_cast<uint16_t>(key.letterSpace)) << 16) |
+             static_cast<uint64_t>(static_cast<uint16_t>(key.lineSpace));
+        return static_cast<size_t>(h);
+    }
+};
+
+static uint64_t hash_text(const char* text)
+{
+    // FNV-1a
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (const char* p = text; *p; ++p) {
+        h = (h ^ static_cast<uint8_t>(*p)) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+class TextSizeCache
+{
+public:
+    static constexpr size_t kCapacity = 256;
+
+    bool lookup(const TextSizeKey& key, const char* text, lv_point_t& size)
+    {
+        auto it = mIndex.find(key);
+        if (it == mIndex.end() || it->second->text != text) {
+            ++mStats.misses;
+            return false;
+        }
+        mLru.splice(mLru.begin(), mLru, it->second);
+        size = it->second->size;
+        ++mStats.hits;
+        return true;
+    }
+
+    void insert(const TextSizeKey& key, const char* text, const lv_point_t& size)
+    {
+        auto it = mIndex.find(key);
+        if (it != mIndex.end()) {
+            it->second->text = text;
+            it->second->size = size;
+            mLru.splice(mLru.begin(), mLru, it->second);
+            return;
+        }
+        if (mLru.size() >= kCapacity) {
+            mIndex.erase(mLru.back().key);
+            mLru.pop_back();
+            ++mStats.evictions;
+        }
+        mLru.push_front(Entry{key, text, size});
+        mIndex.emplace(key, mLru.begin());
+    }
+
+    TextCacheStats stats() const
+    {
+        TextCacheStats stats = mStats;
+        stats.entries = mLru.size();
+        stats.capacity = kCapacity;
+        return stats;
+    }
+
+    void resetStats() { mStats = TextCacheStats{}; }
+
+private:
+    struct Entry
+    {
+        TextSizeKey key;
+        std::string text;
+        lv_point_t size;
+    };
+
+    std::list<Entry> mLru;
+    std::unordered_map<TextSizeKey, std::list<Entry>::iterator, TextSizeKeyHash> mIndex;
+    TextCacheStats mStats;
+};
+
+static TextSizeCache gTextSizeCache;
+
+style::Size _lvMeasureText(lv_obj_t* obj, const char* text, int maxWidth)
+{
+    if (!text) text = "";
+    TextSizeKey key{
+        lv_obj_get_style_text_font(obj, LV_PART_MAIN),
+        hash_text(text),
+        static_cast<coord_t>(maxWidth),
+        lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN),
+        lv_obj_get_style_text_line_space(obj, LV_PART_MAIN)
+    };
+
+    lv_point_t size;
+    if (!gTextSizeCache.lookup(key, text, size)) {
+        text_get_size(&size, text, key.font, key.letterSpace, key.lineSpace, key.maxWidth, LV_TEXT_FLAG_NONE);
+        gTextSizeCache.insert(key, text, size);
+    }
+    return style::Size{size.x, size.y};
+}
+
+TextCacheStats _lvGetTextCacheStats()
+{
+    return gTextSizeCache.stats();
+}
+
+void _lvResetTextCacheStats()
+{
+    gTextSizeCache.resetStats();
+}
+
+/**
+ * @brief lv_label_set_text / lv_label_set_text_static, skipping a copied text equal to the current one
+ * @param[in] isStatic Reference text instead of copying it
+ * @note Setting the same static pointer again still refreshes, the caller may have changed the buffer
+ */
+static void set_label_text(lv_obj_t* obj, const char* text, bool isStatic)
+{
+    if (isStatic) {
+        lv_label_set_text_static(obj, text);
+        return;
+    }
+    const char* current = lv_label_get_text(obj);
+    if (text && current && text != current && strcmp(text, current) == 0) {
+        return;
+    }
+    lv_label_set_text(obj, text);
+}
+
+lv_obj_t* _lvCreateLabel(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateLabel, track_created(lv_label_create(parent)), parent);
+}
+
+void _lvSetText(lv_obj_t* obj, const char* text)
+{
+    record_call(RecordOp::SetText, obj, text);
+    set_label_text(obj, text, false);
+}
+
+void _lvSetTextStatic(lv_obj_t* obj, const char* text)
+{
+    record_call(RecordOp::SetTextStatic, obj, text);
+    // LVGL keeps the pointer instead of copying, the caller guarantees static storage
+    set_label_text(obj, text, true);
+}
+
+lv_obj_t* _lvCreateButton(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateButton, track_created(button_create(parent)), parent);
+}
+
+// Return the label child of a button, creating it on first use
+static lv_obj_t* button_label(lv_obj_t* obj)
+{
+    lv_obj_t* label = lv_obj_get_child(obj, 0);
+    if (!label || !lv_obj_check_type(label, &lv_label_class)) {
+        label = track_created(lv_label_create(obj));
+        lv_obj_center(label);
+    }
+    return label;
+}
+
+void _lvSetButtonText(lv_obj_t* obj, const char* text)
+{
+    record_call(RecordOp::SetButtonText, obj, text);
+    if (!text) return;
+
+    set_label_text(button_label(obj), text, false);
+}
+
+void _lvSetButtonTextStatic(lv_obj_t* obj, const char* text)
+{
+    record_call(RecordOp::SetButtonTextStatic, obj, text);
+    if (!text) return;
+
+    set_label_text(button_label(obj), text, true);
+}
+
+void _lvSetOnClick(lv_obj_t* obj, std::function<void()> callback)
+{
+    record_call(RecordOp::SetOnClick, obj);
+    EventDispatcher::instance().add(obj, LV_EVENT_CLICKED, EventArg::None, std::move(callback));
+}
+
+void _lvSetOnChildClick(lv_obj_t* obj, std::function<void(lv_obj_t*)> callback)
+{
+    record_call(RecordOp::SetOnChildClick, obj);
+    EventDispatcher::instance().add(obj, LV_EVENT_CLICKED, EventArg::Child, std::move(callback));
+}
+
+void _lvSetEventBubble(lv_obj_t* obj, bool isEnabled)
+{
+    record_call(RecordOp::SetEventBubble, obj, isEnabled);
+    if (isEnabled) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE);
+    } else {
+        obj_remove_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE);
+    }
+}
+
+void _lvSetSize(lv_obj_t* obj, const gui::style::Size& size)
+{
+    record_call(RecordOp::SetSize, obj, size.width, size.height);
+    lv_obj_set_size(obj, size.width, size.height);
+}
+
+void _lvSetTextColor(lv_obj_t* obj, lv_color_t color)
+{
+    record_call(RecordOp::SetTextColorNative, obj, from_lv_color(color));
+    lv_obj_set_style_text_color(obj, color, LV_PART_MAIN);
+}
+
+void _lvSetTextColor(lv_obj_t* obj, const gui::style::Color& color)
+{
+    record_call(RecordOp::SetTextColor, obj, color);
+    lv_obj_set_style_text_color(obj, to_lv_color(color), LV_PART_MAIN);
+    lv_obj_set_style_text_opa(obj, to_lv_opa(color), LV_PART_MAIN);
+}
+
+void _lvSetWidth(lv_obj_t* obj, int width)
+{
+    record_call(RecordOp::SetWidth, obj, width);
+    lv_obj_set_width(obj, width);
+}
+
+void _lvSetHeight(lv_obj_t* obj, int height)
+{
+    record_call(RecordOp::SetHeight, obj, height);
+    lv_obj_set_height(obj, height);
+}
+
+void _lvSetBgColor(lv_obj_t* obj, lv_color_t color)
+{
+    record_call(RecordOp::SetBgColorNative, obj, from_lv_color(color));
+    lv_obj_set_style_bg_color(obj, color, LV_PART_MAIN);
+}
+
+void _lvSetBgColor(lv_obj_t* obj, const gui::style::Color& color)
+{
+    record_call(RecordOp::SetBgColor, obj, color);
+    lv_obj_set_style_bg_color(obj, to_lv_color(color), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(obj, to_lv_opa(color), LV_PART_MAIN);
+}
+
+void _lvSetEnabled(lv_obj_t* obj, bool isEnabled)
+{
+    record_call(RecordOp::SetEnabled, obj, isEnabled);
+    if (isEnabled) {
+        obj_remove_state(obj, LV_STATE_DISABLED);
+    } else {
+        lv_obj_add_state(obj, LV_STATE_DISABLED);
+    }
+}
+
+// Progress Bar implementations
+lv_obj_t* _lvCreateProgressBar(lv_obj_t* parent, int value)
+{
+    lv_obj_t* bar = track_created(lv_bar_create(parent));
+    lv_bar_set_value(bar, value, LV_ANIM_ON);
+    return record_created(RecordOp::CreateProgressBar, bar, parent, value);
+}
+
+// Spinner implementations
+lv_obj_t* _lvCreateSpinner(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateSpinner, track_created(spinner_create(parent, 1000, 60)), parent);
+}
+
+void _lvSetSpinnerTime(lv_obj_t* obj, uint32_t time)
+{
+    record_call(RecordOp::SetSpinnerTime, obj, time);
+    // Note: LVGL spinner doesn't have a direct API to set animation time
+    // We'll use the default animation time
+}
+
+void _lvSetSpinnerAngle(lv_obj_t* obj, uint16_t angle)
+{
+    record_call(RecordOp::SetSpinnerAngle, obj, uint32_t(angle));
+    // Note: LVGL spinner doesn't have a direct API to set angle
+    // We'll use the default angle
+}
+
+// Text Area implementations
+lv_obj_t* _lvCreateTextArea(lv_obj_t* parent, const char* placeholder)
+{
+    lv_obj_t* ta = track_created(lv_textarea_create(parent));
+    if (placeholder) {
+        lv_textarea_set_placeholder_text(ta, placeholder);
+    }
+    return record_created(RecordOp::CreateTextArea, ta, parent, placeholder);
+}
+
+void _lvSetTextAreaText(lv_obj_t* obj, const char* text)
+{
+    record_call(RecordOp::SetTextAreaText, obj, text);
+    lv_textarea_set_text(obj, text);
+}
+
+void _lvSetTextAreaPlaceholder(lv_obj_t* obj, const char* placeholder)
+{
+    record_call(RecordOp::SetTextAreaPlaceholder, obj, placeholder);
+    lv_textarea_set_placeholder_text(obj, placeholder);
+}
+
+void _lvSetTextAreaOnTextChanged(lv_obj_t* obj, std::function<void(const std::string&)> callback,
+                                 const EventPolicy& policy)
+{
+    record_call(RecordOp::SetTextAreaOnTextChanged, obj, policy);
+    EventDispatcher::instance().add(obj, LV_EVENT_VALUE_CHANGED, EventArg::TextAreaText, std::move(callback),
+                                    policy);
+}
+
+void _lvSetTextAreaMaxLength(lv_obj_t* obj, uint32_t max_len)
+{
+    record_call(RecordOp::SetTextAreaMaxLength, obj, max_len);
+    lv_textarea_set_max_length(obj, max_len);
+}
+
+
+// List implementations
+lv_obj_t* _lvCreateList(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateList, track_created(lv_list_create(parent)), parent);
+}
+
+void _lvAddListItem(lv_obj_t* obj, const char* text)
+{
+    record_call(RecordOp::AddListItem, obj, text);
+    lv_list_add_text(obj, text);
+}
+
+static void set_list_item_index(lv_obj_t* item, size_t index)
+{
+    lv_obj_set_user_data(item, reinterpret_cast<void*>(static_cast<uintptr_t>(index)));
+}
+
+void _lvAddListItems(lv_obj_t* obj, const char* const* texts, size_t count)
+{
+    record_call(RecordOp::AddListItems, obj, RecordTexts{texts, count});
+    if (count == 0) return;
+
+    // Hidden objects skip invalidation, so the whole batch costs one redraw instead of one per row
+    bool wasHidden = lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    if (!wasHidden) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    size_t index = child_count(obj);
+    for (size_t i = 0; i < count; ++i) {
+        lv_obj_t* item = list_add_button(obj, texts[i]);
+        lv_obj_add_flag(item, LV_OBJ_FLAG_EVENT_BUBBLE);
+        set_list_item_index(item, index + i);
+    }
+
+    if (!wasHidden) {
+        obj_remove_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void _lvRemoveListItem(lv_obj_t* obj, size_t index)
+{
+    record_call(RecordOp::RemoveListItem, obj, index);
+    lv_obj_t* item = lv_obj_get_child(obj, static_cast<int32_t>(index));
+    if (!item) return;
+
+    obj_delete(item);
+    uint32_t count = child_count(obj);
+    for (uint32_t i = static_cast<uint32_t>(index); i < count; ++i) {
+        set_list_item_index(lv_obj_get_child(obj, static_cast<int32_t>(i)), i);
+    }
+}
+
+void _lvClearListItems(lv_obj_t* obj)
+{
+    record_call(RecordOp::ClearListItems, obj);
+    lv_obj_clean(obj);
+}
+
+void _lvSetListOnItemSelected(lv_obj_t* obj, std::function<void(int, const std::string&)> callback)
+{
+    record_call(RecordOp::SetListOnItemSelected, obj);
+    EventDispatcher::instance().add(obj, LV_EVENT_CLICKED, EventArg::ListItem, std::move(callback));
+}
+
+// Bar implementations
+lv_obj_t* _lvCreateBar(lv_obj_t* parent, int value)
+{
+    lv_obj_t* bar = track_created(lv_bar_create(parent));
+    lv_bar_set_value(bar, value, LV_ANIM_ON);
+    return record_created(RecordOp::CreateBar, bar, parent, value);
+}
+
+void _lvSetBarRange(lv_obj_t* obj, int min, int max)
+{
+    record_call(RecordOp::SetBarRange, obj, min, max);
+    lv_bar_set_range(obj, min, max);
+}
+
+void _lvSetBarValue(lv_obj_t* obj, int value, bool anim)
+{
+    record_call(RecordOp::SetBarValue, obj, value, anim);
+    lv_bar_set_value(obj, value, anim ? LV_ANIM_ON : LV_ANIM_OFF);
+}
+
+int32_t _lvGetBarTrackLength(lv_obj_t* obj)
+{
+    // lv_bar draws horizontally unless it is taller than wide
+    if (lv_obj_get_width(obj) >= lv_obj_get_height(obj)) {
+        return lv_obj_get_content_width(obj);
+    }
+    return lv_obj_get_content_height(obj);
+}
+
+bool _lvIsBarAnimating(lv_obj_t* obj)
+{
+    auto* bar = reinterpret_cast<lv_bar_t*>(obj);
+    return lv_anim_get(&bar->cur_value_anim, nullptr) != nullptr;
+}
+
+uint32_t _lvTickGet()
+{
+    return lv_tick_get();
+}
+
+void _lvSetBarOnValueChanged(lv_obj_t* obj, std::function<void(int)> callback, const EventPolicy& policy)
+{
+    record_call(RecordOp::SetBarOnValueChanged, obj, policy);
+    EventDispatcher::instance().add(obj, LV_EVENT_VALUE_CHANGED, EventArg::BarValue, std::move(callback), policy);
+}
+
+// --- Slider Implementation ---
+lv_obj_t* _lvCreateSlider(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateSlider, track_created(lv_slider_create(parent)), parent);
+}
+
+void _lvSetSliderRange(lv_obj_t* obj, int min, int max)
+{
+    record_call(RecordOp::SetSliderRange, obj, min, max);
+    lv_slider_set_range(obj, min, max);
+}
+
+void _lvSetSliderValue(lv_obj_t* obj, int value, bool anim)
+{
+    record_call(RecordOp::SetSliderValue, obj, value, anim);
+    lv_slider_set_value(obj, value, anim ? LV_ANIM_ON : LV_ANIM_OFF);
+}
+
+void _lvSetSliderOnValueChanged(lv_obj_t* obj, std::function<void(int)> callback, const EventPolicy& policy)
+{
+    record_call(RecordOp::SetSliderOnValueChanged, obj, policy);
+    EventDispatcher::instance().add(obj, LV_EVENT_VALUE_CHANGED, EventArg::SliderValue, std::move(callback), policy);
+}
+
+// --- Switch Implementation ---
+lv_obj_t* _lvCreateSwitch(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateSwitch, track_created(lv_switch_create(parent)), parent);
+}
+
+void _lvSetSwitchState(lv_obj_t* obj, bool isOn)
+{
+    record_call(RecordOp::SetSwitchState, obj, isOn);
+    if (isOn) {
+        lv_obj_add_state(obj, LV_STATE_CHECKED);
+    } else {
+        obj_remove_state(obj, LV_STATE_CHECKED);
+    }
+}
+
+void _lvSetSwitchOnToggle(lv_obj_t* obj, std::function<void(bool)> callback)
+{
+    record_call(RecordOp::SetSwitchOnToggle, obj);
+    EventDispatcher::instance().add(obj, LV_EVENT_VALUE_CHANGED, EventArg::Checked, std::move(callback));
+}
+
+// --- Checkbox Implementation ---
+lv_obj_t* _lvCreateCheckbox(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateCheckbox, track_created(lv_checkbox_create(parent)), parent);
+}
+
+void _lvSetCheckboxText(lv_obj_t* obj, const char* text)
+{
+    record_call(RecordOp::SetCheckboxText, obj, text);
+    lv_checkbox_set_text(obj, text);
+}
+
+void _lvSetCheckboxState(lv_obj_t* obj, bool isChecked)
+{
+    record_call(RecordOp::SetCheckboxState, obj, isChecked);
+    if (isChecked) {
+        lv_obj_add_state(obj, LV_STATE_CHECKED);
+    } else {
+        obj_remove_state(obj, LV_STATE_CHECKED);
+    }
+}
+
+void _lvSetCheckboxOnToggle(lv_obj_t* obj, std::function<void(bool)> callback)
+{
+    record_call(RecordOp::SetCheckboxOnToggle, obj);
+    EventDispatcher::instance().add(obj, LV_EVENT_VALUE_CHANGED, EventArg::Checked, std::move(callback));
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../../iface/gui/Adaptor.h"
+#include "../../iface/gui/AssetPack.h"
+#include "LvCompat.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Shared adaptor code ====================
+// impls/common implements the adaptor::_lv* functions for both LVGL versions. The functions below are shared
+// between its files, the hooks at the end are what each backend (impls/lv8, impls/lv9) implements itself.
+
+/**
+ * @brief Image decoded into memory, LVGL draws it like a compiled-in image
+ */
+struct DecodedImage
+{
+    image_dsc_t dsc{};
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief Count an object created inside a build scope, the first one (the subtree root) is hidden until the scope
+ * ends
+ * @return obj
+ */
+lv_obj_t* track_created(lv_obj_t* obj);
+
+/**
+ * @brief Monotonic clock in microseconds, for the stats and benchmarks
+ */
+uint64_t steady_us();
+
+// ---------- LVGL-typed adaptor calls ----------
+// Adaptor calls whose arguments are LVGL types, for impls code only since Adaptor.h does not include LVGL
+
+void _lvSetTextColor(lv_obj_t* obj, lv_color_t color);
+void _lvSetBgColor(lv_obj_t* obj, lv_color_t color);
+
+/**
+ * @param[in] src Has to outlive its use by obj, nullptr clears the image
+ */
+void _lvSetImageSrc(lv_obj_t* obj, const image_dsc_t* src);
+
+// ---------- Redraw profiler ----------
+// The backend hooks the display while _lvEnableRedrawProfiler is on and reports what LVGL does through these.
+
+/**
+ * @brief An area was invalidated, counted for the current redraw tag
+ */
+void redraw_invalidated(const lv_area_t* area);
+
+/**
+ * @brief An area was sent to the display
+ */
+void redraw_flushed(const lv_area_t* area);
+
+/**
+ * @brief A refresh ended, it is one frame if it had invalidated areas
+ */
+void redraw_refreshed();
+
+// ---------- Backend hooks ----------
+
+/**
+ * @brief Decode a file in LVGL's binary image format (.bin, the header followed by the pixels)
+ * @return nullptr for a format the backend cannot draw from memory or a truncated file
+ */
+std::shared_ptr<DecodedImage> decode_lvgl_bin(const std::vector<uint8_t>& file);
+
+/**
+ * @brief Decode a PNG file, nullptr if LVGL is built without a usable PNG decoder
+ */
+std::shared_ptr<DecodedImage> decode_png(const std::vector<uint8_t>& file);
+
+/**
+ * @brief Whether the pixels of a pack with this header can be drawn by the LVGL build
+ */
+bool asset_pack_matches(const AssetPackHeader& header);
+
+/**
+ * @brief Describe the image of a pack entry, whose data is at base + entry.offset
+ * @return false rejects the whole pack. An image LVGL cannot draw in place is left without data and not found
+ */
+bool describe_packed_image(const AssetPackHeader& header, const AssetPackEntry& entry, const uint8_t* base,
+                           image_dsc_t& dsc);
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,270 @@
+#include "AdaptorCommon.h"
+#include "Decimate.h"
+#include "EventDispatcher.h"
+#include "Recorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Chart ====================
+// Each series keeps its window twice (sample i at i and i + window), so the newest samples are one contiguous
+// run for the decimation wherever the write position has wrapped to. A frame only redraws when a source had
+// new samples or the size changed.
+
+class ChartState
+{
+public:
+    explicit ChartState(lv_obj_t* obj) : mObj(obj)
+    {
+        mTimer = lv_timer_create(_onTimer, refresh_period(obj), this);
+    }
+
+    ~ChartState()
+    {
+        timer_delete(mTimer);
+    }
+
+    size_t addSeries(const style::Color& color, ChartSource source)
+    {
+        Series series;
+        series.ser = lv_chart_add_series(mObj, to_lv_color(color), LV_CHART_AXIS_PRIMARY_Y);
+        series.source = std::move(source);
+        series.history.assign(2 * size_t(mWindow), 0.0f);
+        mSeries.push_back(std::move(series));
+        mStats.series = static_cast<uint32_t>(mSeries.size());
+        mDirty = true;
+        return mSeries.size() - 1;
+    }
+
+    void setWindow(uint32_t samples)
+    {
+        samples = std::max<uint32_t>(samples, 1);
+        if (samples == mWindow) {
+            return;
+        }
+        for (Series& series : mSeries) {
+            // Keep the newest samples, they start the new history
+            size_t keep = std::min<size_t>(series.filled, samples);
+            const float* newest = _newest(series) + series.filled - keep;
+            std::vector<float> history(2 * size_t(samples), 0.0f);
+            std::copy(newest, newest + keep, history.begin());
+            std::copy(newest, newest + keep, history.begin() + samples);
+            series.history.swap(history);
+            series.position = keep % samples;
+            series.filled = keep;
+        }
+        mWindow = samples;
+        mDirty = true;
+    }
+
+    void onEvent(lv_event_t* e)
+    {
+        // The number of columns follows the content width
+        (void)e;
+        mDirty = true;
+    }
+
+    const ChartStats& stats() const { return mStats; }
+
+private:
+    struct Series
+    {
+        lv_chart_series_t* ser = nullptr;
+        ChartSource source;
+        std::vector<float> history;
+        size_t position = 0;        ///< Where the next sample goes, below the window
+        size_t filled = 0;          ///< Samples in the window
+    };
+
+    static constexpr size_t kPullChunk = 256;
+
+    static void _onTimer(lv_timer_t* timer)
+    {
+        static_cast<ChartState*>(timer_user_data(timer))->_frame();
+    }
+
+    void _frame()
+    {
+        uint64_t start = steady_us();
+        bool changed = mDirty;
+        for (Series& series : mSeries) {
+            changed = _pull(series) || changed;
+        }
+        if (!changed) {
+            return;
+        }
+        mDirty = false;
+        _render();
+
+        uint64_t elapsed = steady_us() - start;
+        ++mStats.frames;
+        mStats.totalFrameUs += elapsed;
+        mStats.maxFrameUs = std::max(mStats.maxFrameUs, elapsed);
+    }
+
+    size_t _pull(Series& series)
+    {
+        if (!series.source) {
+            return 0;
+        }
+        float chunk[kPullChunk];
+        size_t total = 0;
+        // Bounded, a producer outrunning the display must not keep the UI thread here
+        while (total < mWindow + kPullChunk) {
+            size_t count = series.source(chunk, kPullChunk);
+            for (size_t i = 0; i < count; ++i) {
+                series.history[series.position] = chunk[i];
+                series.history[series.position + mWindow] = chunk[i];
+                series.position = series.position + 1 == mWindow ? 0 : series.position + 1;
+            }
+            total += count;
+            if (count < kPullChunk) {
+                break;
+            }
+        }
+        series.filled = std::min<size_t>(series.filled + total, mWindow);
+        mStats.samples += total;
+        return total;
+    }
+
+    const float* _newest(const Series& series) const
+    {
+        return series.history.data() + (series.position + mWindow - series.filled) % mWindow;
+    }
+
+    static coord_t _toCoord(float value)
+    {
+        // LV_CHART_POINT_NONE is LV_COORD_MAX (INT32_MAX in LVGL 9), a clipped sample must not become a gap
+        float clamped = std::min(std::max(value, float(-LV_COORD_MAX)), float(LV_COORD_MAX - 1));
+        return static_cast<coord_t>(std::lround(clamped));
+    }
+
+    void _render()
+    {
+        coord_t width = lv_obj_get_content_width(mObj);
+        size_t columns = std::min<size_t>(std::max<coord_t>(width, 1), std::min<uint32_t>(mWindow, UINT16_MAX / 2));
+        // Every column is drawn as its minimum followed by its maximum
+        auto points = static_cast<uint16_t>(2 * columns);
+        if (lv_chart_get_point_count(mObj) != points) {
+            lv_chart_set_point_count(mObj, points);
+        }
+        mMins.resize(columns);
+        mMaxs.resize(columns);
+
+        for (Series& series : mSeries) {
+            coord_t* y = lv_chart_get_y_array(mObj, series.ser);
+            // A window that is not full yet keeps the density and grows from the right
+            size_t used = std::min(std::max<size_t>(columns * series.filled / mWindow, 1), series.filled);
+            size_t offset = 2 * (columns - used);
+            std::fill(y, y + offset, LV_CHART_POINT_NONE);
+            if (used == 0) {
+                continue;
+            }
+            decimate_min_max(_newest(series), series.filled, used, mMins.data(), mMaxs.data());
+            for (size_t i = 0; i < used; ++i) {
+                y[offset + 2 * i] = _toCoord(mMins[i]);
+                y[offset + 2 * i + 1] = _toCoord(mMaxs[i]);
+            }
+        }
+        lv_chart_refresh(mObj);
+        mStats.columns = static_cast<uint32_t>(columns);
+    }
+
+    lv_obj_t* mObj;
+    lv_timer_t* mTimer = nullptr;
+    uint32_t mWindow = 1000;
+    bool mDirty = true;
+    std::vector<Series> mSeries;
+    std::vector<float> mMins;
+    std::vector<float> mMaxs;
+    ChartStats mStats;
+};
+
+static ChartState* chart_state(lv_obj_t* obj)
+{
+    return static_cast<ChartState*>(lv_obj_get_user_data(obj));
+}
+
+lv_obj_t* _lvCreateChart(lv_obj_t* parent)
+{
+    lv_obj_t* obj = track_created(lv_chart_create(parent));
+    lv_chart_set_type(obj, LV_CHART_TYPE_LINE);
+    // Two points per pixel column, point markers would cover the line
+    set_style_square_size(obj, 0, LV_PART_INDICATOR);
+
+    // Owned by the handler, released with it when the object is deleted
+    auto state = std::make_shared<ChartState>(obj);
+    lv_obj_set_user_data(obj, state.get());
+    auto handler = std::function<void(lv_event_t*)>([state](lv_event_t* e) { state->onEvent(e); });
+    auto& dispatcher = EventDispatcher::instance();
+    for (lv_event_code_t code : {LV_EVENT_SIZE_CHANGED, LV_EVENT_STYLE_CHANGED}) {
+        dispatcher.add(obj, code, EventArg::Event, handler);
+    }
+    return record_created(RecordOp::CreateChart, obj, parent);
+}
+
+size_t _lvAddChartSeries(lv_obj_t* obj, const style::Color& color, ChartSource source)
+{
+    record_call(RecordOp::AddChartSeries, obj, color);
+    return chart_state(obj)->addSeries(color, record_chart_source(obj, std::move(source)));
+}
+
+void _lvSetChartRange(lv_obj_t* obj, int min, int max)
+{
+    record_call(RecordOp::SetChartRange, obj, min, max);
+    lv_chart_set_range(obj, LV_CHART_AXIS_PRIMARY_Y, static_cast<coord_t>(min), static_cast<coord_t>(max));
+}
+
+void _lvSetChartWindow(lv_obj_t* obj, uint32_t samples)
+{
+    record_call(RecordOp::SetChartWindow, obj, samples);
+    chart_state(obj)->setWindow(samples);
+}
+
+ChartStats _lvGetChartStats(lv_obj_t* obj)
+{
+    return chart_state(obj)->stats();
+}
+
+DecimationBenchmark _lvBenchmarkDecimation(uint32_t samples, uint32_t columns, uint32_t rounds)
+{
+    DecimationBenchmark result;
+    result.path = decimate_path();
+    samples = std::max<uint32_t>(samples, 1);
+    columns = std::min(std::max<uint32_t>(columns, 1), samples);
+    rounds = std::max<uint32_t>(rounds, 1);
+
+    // A noisy sine, nothing the branch predictor could learn
+    std::vector<float> input(samples);
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < samples; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        input[i] = 50.0f * std::sin(float(i) * 0.01f) + float(seed >> 8) / float(1 << 24);
+    }
+    std::vector<float> mins(columns);
+    std::vector<float> maxs(columns);
+    volatile float sink = 0.0f;
+
+    uint64_t start = steady_us();
+    for (uint32_t r = 0; r < rounds; ++r) {
+        decimate_min_max_scalar(input.data(), samples, columns, mins.data(), maxs.data());
+        sink = sink + mins[r % columns];
+    }
+    result.scalarUs = double(steady_us() - start) / rounds;
+
+    start = steady_us();
+    for (uint32_t r = 0; r < rounds; ++r) {
+        decimate_min_max(input.data(), samples, columns, mins.data(), maxs.data());
+        sink = sink + mins[r % columns];
+    }
+    result.vectorUs = double(steady_us() - start) / rounds;
+    return result;
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,132 @@
+#include "Decimate.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#if defined(__SSE__)
+#define DECIMATE_SSE 1
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DECIMATE_NEON 1
+#endif
+
+namespace gui {
+namespace adaptor {
+
+static inline void bucket_scalar(const float* samples, size_t begin, size_t end, float& lo, float& hi)
+{
+    for (size_t i = begin; i < end; ++i) {
+        float v = samples[i];
+        lo = v < lo ? v : lo;
+        hi = v > hi ? v : hi;
+    }
+}
+
+#if DECIMATE_SSE
+static inline void bucket_vector(const float* samples, size_t begin, size_t end, float& lo, float& hi)
+{
+    size_t i = begin;
+    if (end - begin >= 8) {
+        // Two accumulators each, the min/max latency would otherwise bound the loop
+        __m128 lo0 = _mm_loadu_ps(samples + i);
+        __m128 hi0 = lo0;
+        __m128 lo1 = _mm_loadu_ps(samples + i + 4);
+        __m128 hi1 = lo1;
+        for (i += 8; i + 8 <= end; i += 8) {
+            __m128 a = _mm_loadu_ps(samples + i);
+            __m128 b = _mm_loadu_ps(samples + i + 4);
+            lo0 = _mm_min_ps(lo0, a);
+            hi0 = _mm_max_ps(hi0, a);
+            lo1 = _mm_min_ps(lo1, b);
+            hi1 = _mm_max_ps(hi1, b);
+        }
+        __m128 l = _mm_min_ps(lo0, lo1);
+        __m128 h = _mm_max_ps(hi0, hi1);
+        l = _mm_min_ps(l, _mm_movehl_ps(l, l));
+        h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+        l = _mm_min_ss(l, _mm_shuffle_ps(l, l, 1));
+        h = _mm_max_ss(h, _mm_shuffle_ps(h, h, 1));
+        float vl = _mm_cvtss_f32(l);
+        float vh = _mm_cvtss_f32(h);
+        lo = vl < lo ? vl : lo;
+        hi = vh > hi ? vh : hi;
+    }
+    bucket_scalar(samples, i, end, lo, hi);
+}
+#elif DECIMATE_NEON
+static inline void bucket_vector(const float* samples, size_t begin, size_t end, float& lo, float& hi)
+{
+    size_t i = begin;
+    if (end - begin >= 8) {
+        float32x4_t lo0 = vld1q_f32(samples + i);
+        float32x4_t hi0 = lo0;
+        float32x4_t lo1 = vld1q_f32(samples + i + 4);
+        float32x4_t hi1 = lo1;
+        for (i += 8; i + 8 <= end; i += 8) {
+            float32x4_t a = vld1q_f32(samples + i);
+            float32x4_t b = vld1q_f32(samples + i + 4);
+            lo0 = vminq_f32(lo0, a);
+            hi0 = vmaxq_f32(hi0, a);
+            lo1 = vminq_f32(lo1, b);
+            hi1 = vmaxq_f32(hi1, b);
+        }
+        float32x4_t l = vminq_f32(lo0, lo1);
+        float32x4_t h = vmaxq_f32(hi0, hi1);
+        // vminvq is AArch64 only, reduce pairwise to stay 32 bit ARM compatible
+        float32x2_t l2 = vpmin_f32(vget_low_f32(l), vget_high_f32(l));
+        float32x2_t h2 = vpmax_f32(vget_low_f32(h), vget_high_f32(h));
+        l2 = vpmin_f32(l2, l2);
+        h2 = vpmax_f32(h2, h2);
+        float vl = vget_lane_f32(l2, 0);
+        float vh = vget_lane_f32(h2, 0);
+        lo = vl < lo ? vl : lo;
+        hi = vh > hi ? vh : hi;
+    }
+    bucket_scalar(samples, i, end, lo, hi);
+}
+#endif
+
+template <void (*Bucket)(const float*, size_t, size_t, float&, float&)>
+static void decimate(const float* samples, size_t count, size_t buckets, float* mins, float* maxs)
+{
+    size_t begin = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        size_t end = (b + 1) * count / buckets;
+        float lo = samples[begin];
+        float hi = samples[begin];
+        Bucket(samples, begin + 1, end, lo, hi);
+        mins[b] = lo;
+        maxs[b] = hi;
+        begin = end;
+    }
+}
+
+const char* decimate_path()
+{
+#if DECIMATE_SSE
+    return "sse";
+#elif DECIMATE_NEON
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void decimate_min_max(const float* samples, size_t count, size_t buckets, float* mins, float* maxs)
+{
+#if DECIMATE_SSE || DECIMATE_NEON
+    decimate<bucket_vector>(samples, count, buckets, mins, maxs);
+#else
+    decimate<bucket_scalar>(samples, count, buckets, mins, maxs);
+#endif
+}
+
+void decimate_min_max_scalar(const float* samples, size_t count, size_t buckets, float* mins, float* maxs)
+{
+    decimate<bucket_scalar>(samples, count, buckets, mins, maxs);
+}
+
+} // namespace adaptor
+} // namespace gui
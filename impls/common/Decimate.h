@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Min/max decimation ====================
+// Reduces a sample series to one minimum and one maximum per pixel column, so a peak between two columns
+// stays visible. Independent of LVGL. Samples must not be NaN, the vector paths would drop them differently.
+
+/**
+ * @brief Name of the compiled-in vector path, "scalar" without one
+ */
+const char* decimate_path();
+
+/**
+ * @brief Minimum and maximum of each bucket
+ * @param[in] samples Input, bucket i covers [i * count / buckets, (i + 1) * count / buckets)
+ * @param[in] count Number of samples, at least buckets
+ * @param[in] buckets Number of buckets, the size of mins and maxs
+ */
+void decimate_min_max(const float* samples, size_t count, size_t buckets, float* mins, float* maxs);
+
+/**
+ * @brief Same as decimate_min_max without the vector path, the reference for the benchmark
+ */
+void decimate_min_max_scalar(const float* samples, size_t count, size_t buckets, float* mins, float* maxs);
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,286 @@
+#include "EventDispatcher.h"
+
+namespace gui {
+namespace adaptor {
+
+EventDispatcher& EventDispatcher::instance()
+{
+    static EventDispatcher sInstance;
+    return sInstance;
+}
+
+void EventDispatcher::add(lv_obj_t* obj, lv_event_code_t code, EventArg arg, EventHandler handler,
+                          const EventPolicy& policy)
+{
+    uint32_t slot = _acquire(obj);
+    mSlots[slot].codeMask |= _bit(code);
+    // Deferred deliveries have no event to resolve the child index from
+    bool needsEvent = arg == EventArg::Child || arg == EventArg::ListItem || arg == EventArg::Event;
+    EventPolicy effective = needsEvent ? EventPolicy::immediate() : policy;
+    mSlots[slot].entries.push_back(Entry{code, arg, std::make_shared<const EventHandler>(std::move(handler)),
+                                         effective});
+}
+
+void EventDispatcher::retain(lv_obj_t* obj, std::shared_ptr<const void> resource)
+{
+    mSlots[_acquire(obj)].resource = std::move(resource);
+}
+
+ImageTicket EventDispatcher::request(lv_obj_t* obj)
+{
+    uint32_t slot = _acquire(obj);
+    return ImageTicket{slot, mSlots[slot].generation, ++mSlots[slot].requests, 0};
+}
+
+lv_obj_t* EventDispatcher::resolve(const ImageTicket& ticket) const
+{
+    if (ticket.slot >= mSlots.size()) {
+        return nullptr;
+    }
+    const Slot& s = mSlots[ticket.slot];
+    if (!s.obj || s.released || s.generation != ticket.generation || s.requests != ticket.sequence) {
+        return nullptr;
+    }
+    return s.obj;
+}
+
+uint64_t EventDispatcher::_bit(lv_event_code_t code)
+{
+    uint32_t index = static_cast<uint32_t>(code) & ~static_cast<uint32_t>(LV_EVENT_PREPROCESS);
+    return index < 64 ? (1ULL << index) : 0;
+}
+
+void* EventDispatcher::_slotData(uint32_t slot)
+{
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(slot) + 1);
+}
+
+void EventDispatcher::_onEvent(lv_event_t* e)
+{
+    auto slot = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lv_event_get_user_data(e)) - 1);
+    lv_event_code_t code = lv_event_get_code(e);
+    EventDispatcher& dispatcher = instance();
+    if (code != LV_EVENT_DELETE && !(dispatcher.mSlots[slot].codeMask & _bit(code))) {
+        return;
+    }
+    dispatcher._dispatch(slot, e);
+}
+
+uint32_t EventDispatcher::_acquire(lv_obj_t* obj)
+{
+    void* userData = event_user_data(obj, _onEvent);
+    if (userData) {
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData) - 1);
+    }
+
+    uint32_t slot;
+    if (!mFreeSlots.empty()) {
+        slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(mSlots.size());
+        mSlots.emplace_back();
+    }
+    mSlots[slot].obj = obj;
+    lv_obj_add_event_cb(obj, _onEvent, LV_EVENT_ALL, _slotData(slot));
+    return slot;
+}
+
+void EventDispatcher::_release(uint32_t slot)
+{
+    Slot& s = mSlots[slot];
+    if (s.busy > 0) {
+        // The object was deleted from one of its own handlers, finish the dispatch first
+        s.released = true;
+        return;
+    }
+    for (Entry& entry : s.entries) {
+        if (entry.timer) {
+            timer_delete(entry.timer);
+        }
+    }
+    s.obj = nullptr;
+    s.codeMask = 0;
+    s.released = false;
+    s.entries.clear();
+    s.resource.reset();
+    ++s.generation;
+    mFreeSlots.push_back(slot);
+}
+
+void EventDispatcher::_dispatch(uint32_t slot, lv_event_t* e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_DELETE) {
+        _release(slot);
+        return;
+    }
+
+    ++mSlots[slot].busy;
+    // Index based, handlers may register more handlers on the same object
+    for (size_t i = 0; i < mSlots[slot].entries.size() && !mSlots[slot].released; ++i) {
+        if (mSlots[slot].entries[i].code != code) {
+            continue;
+        }
+        if (mSlots[slot].entries[i].policy.isImmediate()) {
+            const Entry& entry = mSlots[slot].entries[i];
+            _invoke(entry.arg, entry.handler, mSlots[slot].obj, e);
+        } else {
+            _schedule(slot, static_cast<uint32_t>(i), e);
+        }
+    }
+    if (--mSlots[slot].busy == 0 && mSlots[slot].released) {
+        _release(slot);
+    }
+}
+
+// ---------- Throttle / debounce ----------
+// The timer user data is the slot and the entry index, entries are only appended until the slot is
+// released and releasing the slot deletes the timers.
+
+void EventDispatcher::_schedule(uint32_t slot, uint32_t index, lv_event_t* e)
+{
+    Entry& entry = mSlots[slot].entries[index];
+    const EventPolicy& policy = entry.policy;
+
+    if (policy.mode == EventPolicy::Mode::Debounce) {
+        if (!entry.armed && policy.leading) {
+            _deliverNow(entry, mSlots[slot].obj, e);
+        } else {
+            entry.pending = true;
+        }
+        // Every event restarts the quiet period
+        _arm(slot, index, policy.intervalMs);
+        return;
+    }
+
+    uint32_t elapsed = lv_tick_elaps(entry.lastDelivery);
+    if (!entry.armed && policy.leading && (!entry.delivered || elapsed >= policy.intervalMs)) {
+        _deliverNow(entry, mSlots[slot].obj, e);
+        return;
+    }
+    if (!policy.trailing) {
+        return;
+    }
+    entry.pending = true;
+    if (!entry.armed) {
+        uint32_t wait = policy.intervalMs;
+        if (policy.leading && entry.delivered && elapsed < policy.intervalMs) {
+            wait = policy.intervalMs - elapsed;
+        }
+        _arm(slot, index, wait);
+    }
+}
+
+void EventDispatcher::_deliverNow(Entry& entry, lv_obj_t* obj, lv_event_t* e)
+{
+    entry.pending = false;
+    entry.delivered = true;
+    entry.lastDelivery = lv_tick_get();
+    _invoke(entry.arg, entry.handler, obj, e);
+}
+
+void EventDispatcher::_arm(uint32_t slot, uint32_t index, uint32_t periodMs)
+{
+    Entry& entry = mSlots[slot].entries[index];
+    if (!entry.timer) {
+        entry.timerKey.reset(new TimerKey{slot, index});
+        entry.timer = lv_timer_create(_onTimer, periodMs, entry.timerKey.get());
+    }
+    lv_timer_set_period(entry.timer, periodMs);
+    lv_timer_reset(entry.timer);
+    lv_timer_resume(entry.timer);
+    entry.armed = true;
+}
+
+void EventDispatcher::_onTimer(lv_timer_t* timer)
+{
+    auto* key = static_cast<const TimerKey*>(timer_user_data(timer));
+    instance()._fire(key->slot, key->index);
+}
+
+void EventDispatcher::_fire(uint32_t slot, uint32_t index)
+{
+    Entry& entry = mSlots[slot].entries[index];
+    lv_timer_pause(entry.timer);
+    entry.armed = false;
+    if (!entry.pending) {
+        return;
+    }
+
+    ++mSlots[slot].busy;
+    _deliverNow(entry, mSlots[slot].obj, nullptr);
+    if (--mSlots[slot].busy == 0 && mSlots[slot].released) {
+        _release(slot);
+    }
+}
+
+// Resolve a bubbled event to the direct child of obj it originated from
+lv_obj_t* EventDispatcher::_directChild(lv_obj_t* obj, lv_event_t* e)
+{
+    lv_obj_t* child = e ? event_target(e) : nullptr;
+    while (child && child != obj && lv_obj_get_parent(child) != obj) {
+        child = lv_obj_get_parent(child);
+    }
+    return child != obj ? child : nullptr;
+}
+
+/**
+ * @param[in] handler Taken by value, the entry it comes from may move while the handler runs
+ */
+void EventDispatcher::_invoke(EventArg arg, std::shared_ptr<const EventHandler> handler, lv_obj_t* obj,
+                              lv_event_t* e)
+{
+    switch (arg) {
+        case EventArg::None: {
+            auto& fn = std::get<std::function<void()>>(*handler);
+            if (fn) fn();
+        }
+        break;
+        case EventArg::BarValue: {
+            auto& fn = std::get<std::function<void(int)>>(*handler);
+            if (fn) fn(lv_bar_get_value(obj));
+        }
+        break;
+        case EventArg::SliderValue: {
+            auto& fn = std::get<std::function<void(int)>>(*handler);
+            if (fn) fn(lv_slider_get_value(obj));
+        }
+        break;
+        case EventArg::Checked: {
+            auto& fn = std::get<std::function<void(bool)>>(*handler);
+            if (fn) fn(lv_obj_has_state(obj, LV_STATE_CHECKED));
+        }
+        break;
+        case EventArg::TextAreaText: {
+            auto& fn = std::get<std::function<void(const std::string&)>>(*handler);
+            if (fn) fn(std::string(lv_textarea_get_text(obj)));
+        }
+        break;
+        case EventArg::ListItem: {
+            auto& fn = std::get<std::function<void(int, const std::string&)>>(*handler);
+            lv_obj_t* item = _directChild(obj, e);
+            if (fn && item) {
+                fn(static_cast<int>(reinterpret_cast<uintptr_t>(lv_obj_get_user_data(item))),
+                   std::string(list_button_text(obj, item)));
+            }
+        }
+        break;
+        case EventArg::Child: {
+            auto& fn = std::get<std::function<void(lv_obj_t*)>>(*handler);
+            lv_obj_t* child = _directChild(obj, e);
+            if (fn && child) {
+                fn(child);
+            }
+        }
+        break;
+        case EventArg::Event: {
+            auto& fn = std::get<std::function<void(lv_event_t*)>>(*handler);
+            if (fn) fn(e);
+        }
+        break;
+    }
+}
+
+} // namespace adaptor
+} // namespace gui
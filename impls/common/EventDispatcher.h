@@ -0,0 +1,125 @@
+#pragma once
+
+#include "../../iface/gui/Adaptor.h"
+#include "LvCompat.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Event dispatcher ====================
+// Every interactive object registers the dispatcher callback once, for LV_EVENT_ALL, so an object costs one
+// event descriptor however many codes it has handlers for. The user data is a slot in a shared table. A slot
+// holds the handlers of that object by event code and a mask of those codes, the callback drops the draw and
+// input events nobody listens to with one test of the mask. The argument each handler wants is read from the
+// object at dispatch time, and LV_EVENT_DELETE releases the slot centrally.
+// Handlers with a throttle or debounce policy are delivered from a per-handler LVGL timer, which reads
+// the value again when it fires so the last value of a burst is never lost.
+
+enum class EventArg : uint8_t {
+    None,
+    BarValue,
+    SliderValue,
+    Checked,
+    TextAreaText,
+    ListItem,
+    Child,      ///< The direct child of the object the event originated from
+    Event       ///< The handler reads what it needs from the event itself
+};
+
+using EventHandler = std::variant<
+    std::function<void()>,
+    std::function<void(int)>,
+    std::function<void(bool)>,
+    std::function<void(const std::string&)>,
+    std::function<void(int, const std::string&)>,
+    std::function<void(lv_obj_t*)>,
+    std::function<void(lv_event_t*)>>;
+
+class EventDispatcher
+{
+public:
+    static EventDispatcher& instance();
+
+    void add(lv_obj_t* obj, lv_event_code_t code, EventArg arg, EventHandler handler,
+             const EventPolicy& policy = EventPolicy::immediate());
+
+    /**
+     * @brief Keep a resource alive until the object is deleted or another resource replaces it
+     */
+    void retain(lv_obj_t* obj, std::shared_ptr<const void> resource);
+
+    /**
+     * @brief Start a request on the object, supersedes the requests started before
+     */
+    ImageTicket request(lv_obj_t* obj);
+
+    /**
+     * @brief Object of the request, nullptr if it was deleted or a later request was started
+     */
+    lv_obj_t* resolve(const ImageTicket& ticket) const;
+
+private:
+    struct TimerKey
+    {
+        uint32_t slot;
+        uint32_t index;
+    };
+
+    struct Entry
+    {
+        lv_event_code_t code;
+        EventArg arg;
+        // Shared so a dispatch can hold on to it, a handler that adds handlers reallocates the entries
+        std::shared_ptr<const EventHandler> handler;
+
+        EventPolicy policy;
+        lv_timer_t* timer = nullptr;
+        std::unique_ptr<TimerKey> timerKey = nullptr;  ///< User data of the timer, stays put when the entries grow
+        uint32_t lastDelivery = 0;
+        bool delivered = false;
+        bool pending = false;
+        bool armed = false;
+    };
+
+    struct Slot
+    {
+        lv_obj_t* obj = nullptr;
+        uint32_t generation = 0;
+        uint64_t codeMask = 0;
+        uint16_t busy = 0;
+        bool released = false;
+        std::vector<Entry> entries;
+        std::shared_ptr<const void> resource;
+        uint32_t requests = 0;
+    };
+
+    static uint64_t _bit(lv_event_code_t code);
+    static void* _slotData(uint32_t slot);
+    static void _onEvent(lv_event_t* e);
+
+    uint32_t _acquire(lv_obj_t* obj);
+    void _release(uint32_t slot);
+    void _dispatch(uint32_t slot, lv_event_t* e);
+
+    void _schedule(uint32_t slot, uint32_t index, lv_event_t* e);
+    static void _deliverNow(Entry& entry, lv_obj_t* obj, lv_event_t* e);
+    void _arm(uint32_t slot, uint32_t index, uint32_t periodMs);
+    static void _onTimer(lv_timer_t* timer);
+    void _fire(uint32_t slot, uint32_t index);
+
+    static lv_obj_t* _directChild(lv_obj_t* obj, lv_event_t* e);
+    static void _invoke(EventArg arg, std::shared_ptr<const EventHandler> handler, lv_obj_t* obj, lv_event_t* e);
+
+    std::vector<Slot> mSlots;
+    std::vector<uint32_t> mFreeSlots;
+};
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,220 @@
+#include "Headless.h"
+#include "Recorder.h"
+
+#include <chrono>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+static std::unique_ptr<HeadlessDisplay> gHeadless;
+
+static void copy_area(HeadlessDisplay& display, const lv_area_t& area, const uint8_t* pixels)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    size_t width = static_cast<size_t>(lv_area_get_width(&area));
+    size_t srcStride = headless_source_stride(display, width);
+    size_t stride = static_cast<size_t>(display.config.width) * display.bytesPerPixel;
+    for (coord_t y = area.y1; y <= area.y2; ++y) {
+        uint8_t* row = display.framebuffer.data() + static_cast<size_t>(y) * stride + area.x1 * display.bytesPerPixel;
+        if (display.config.format == PixelFormat::Native) {
+            std::memcpy(row, pixels, width * kNativeBytesPerPixel);
+        } else {
+            headless_convert_row(display, pixels, row, width);
+        }
+        pixels += srcStride;
+    }
+
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(display.mutex);
+    ++display.stats.flushes;
+    display.stats.pixels += width * static_cast<size_t>(lv_area_get_height(&area));
+    display.stats.busyNs += static_cast<uint64_t>(ns);
+}
+
+static void flush_worker(HeadlessDisplay* display)
+{
+    while (true) {
+        FlushJob job;
+        {
+            std::unique_lock<std::mutex> lock(display->mutex);
+            display->cv.wait(lock, [display]() { return display->stopping || display->hasJob; });
+            if (!display->hasJob) {
+                return;
+            }
+            job = display->job;
+            display->hasJob = false;
+        }
+
+        copy_area(*display, job.area, job.pixels);
+        // Only flags are written, LVGL documents the flush ready call as safe from another context
+        headless_flush_ready(*display);
+
+        std::lock_guard<std::mutex> lock(display->mutex);
+        if (job.last) {
+            ++display->frames;
+        }
+        display->busy = false;
+        display->cv.notify_all();
+    }
+}
+
+void headless_wait_flushed(HeadlessDisplay& display)
+{
+    std::unique_lock<std::mutex> lock(display.mutex);
+    display.cv.wait(lock, [&display]() { return !display.busy; });
+}
+
+void headless_flush(HeadlessDisplay& display, const lv_area_t& area, const uint8_t* pixels, bool last)
+{
+    if (display.config.doubleBuffered) {
+        std::lock_guard<std::mutex> lock(display.mutex);
+        display.job = FlushJob{area, pixels, last};
+        display.hasJob = true;
+        display.busy = true;
+        display.cv.notify_all();
+        return;
+    }
+
+    copy_area(display, area, pixels);
+    if (last) {
+        ++display.frames;
+    }
+    headless_flush_ready(display);
+}
+
+static void stop_worker(HeadlessDisplay& display)
+{
+    if (!display.worker.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(display.mutex);
+        display.stopping = true;
+    }
+    display.cv.notify_all();
+    display.worker.join();
+}
+
+int _lvCreateHeadlessDisplay(const DisplayConfig& config)
+{
+    if (gHeadless || config.width <= 0 || config.height <= 0) {
+        return -1;
+    }
+
+    auto display = std::make_unique<HeadlessDisplay>();
+    display->config = config;
+    display->bytesPerPixel = config.format == PixelFormat::Rgb565 ? sizeof(uint16_t) : kNativeBytesPerPixel;
+    // Only 32 bit rows have the vector paths of PixelConvert, the other depths convert in a scalar loop
+    display->conversion = LV_COLOR_DEPTH == 32 ? best_pixel_path() : PixelPath::Scalar;
+    bool converts = config.format == PixelFormat::Rgb565 && LV_COLOR_DEPTH != 16;
+    display->stats.conversion = converts ? to_string(display->conversion) : "copy";
+
+    size_t pixels = static_cast<size_t>(config.width) * static_cast<size_t>(config.height);
+    uint32_t lines = config.bufferLines ? config.bufferLines : static_cast<uint32_t>(config.height);
+    lines = lines < static_cast<uint32_t>(config.height) ? lines : static_cast<uint32_t>(config.height);
+    display->framebuffer.assign(pixels * display->bytesPerPixel, 0);
+
+    if (!headless_register(*display, lines)) {
+        return -1;
+    }
+    if (config.doubleBuffered) {
+        display->worker = std::thread(flush_worker, display.get());
+    }
+    gHeadless = std::move(display);
+    return 0;
+}
+
+void _lvDestroyHeadlessDisplay()
+{
+    if (!gHeadless) return;
+
+    stop_worker(*gHeadless);
+    headless_unregister(*gHeadless);
+    gHeadless.reset();
+}
+
+FramebufferView _lvGetFramebuffer()
+{
+    FramebufferView view;
+    if (gHeadless) {
+        headless_wait_flushed(*gHeadless);
+        view.pixels = gHeadless->framebuffer.data();
+        view.width = gHeadless->config.width;
+        view.height = gHeadless->config.height;
+        view.stride = static_cast<uint32_t>(static_cast<size_t>(gHeadless->config.width) * gHeadless->bytesPerPixel);
+        view.bitsPerPixel = gHeadless->config.format == PixelFormat::Rgb565 ? 16 : LV_COLOR_DEPTH;
+    }
+    return view;
+}
+
+FlushStats _lvGetFlushStats()
+{
+    if (!gHeadless) return FlushStats{};
+
+    std::lock_guard<std::mutex> lock(gHeadless->mutex);
+    return gHeadless->stats;
+}
+
+void _lvResetFlushStats()
+{
+    if (!gHeadless) return;
+
+    std::lock_guard<std::mutex> lock(gHeadless->mutex);
+    const char* conversion = gHeadless->stats.conversion;
+    gHeadless->stats = FlushStats{};
+    gHeadless->stats.conversion = conversion;
+}
+
+std::vector<ConversionBenchmark> _lvBenchmarkPixelConversion(size_t pixels, uint32_t rounds)
+{
+    std::vector<uint32_t> src(pixels);
+    std::vector<uint16_t> dst(pixels);
+    uint32_t seed = 0x12345678;
+    for (auto& px : src) {
+        seed = seed * 1664525u + 1013904223u;
+        px = seed;
+    }
+
+    std::vector<ConversionBenchmark> results;
+    for (PixelPath path : {PixelPath::Scalar, PixelPath::Sse2, PixelPath::Avx2, PixelPath::Neon}) {
+        if (!pixel_path_supported(path)) {
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < rounds; ++i) {
+            convert_argb8888_to_rgb565(src.data(), dst.data(), pixels, path);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double megapixels = double(pixels) * rounds / 1e6;
+        results.push_back(ConversionBenchmark{to_string(path), seconds > 0 ? megapixels / seconds : 0.0});
+    }
+    return results;
+}
+
+uint32_t _lvStep(uint32_t ms)
+{
+    record_call(RecordOp::Step, ms);
+    uint32_t framesBefore = 0;
+    if (gHeadless) {
+        std::lock_guard<std::mutex> lock(gHeadless->mutex);
+        framesBefore = gHeadless->frames;
+    }
+
+    lv_tick_inc(ms);
+    lv_timer_handler();
+
+    if (!gHeadless) return 0;
+    // The last part of the frame may still be on the worker
+    headless_wait_flushed(*gHeadless);
+    std::lock_guard<std::mutex> lock(gHeadless->mutex);
+    return gHeadless->frames - framesBefore;
+}
+
+} // namespace adaptor
+} // namespace gui
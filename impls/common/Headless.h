@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../../iface/gui/Adaptor.h"
+#include "LvCompat.h"
+#include "PixelConvert.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Headless display ====================
+// LVGL renders into the draw buffer, the flush copies the finished areas into a full framebuffer in RAM.
+// Nothing depends on wall time as long as LVGL has no tick source of its own (LV_TICK_CUSTOM in LVGL 8,
+// lv_tick_set_cb in LVGL 9): the clock only moves in _lvStep, so a sequence of steps always renders the
+// same frames.
+//
+// Double buffered, the flush callback hands the area to a worker thread and returns, LVGL renders the
+// next part into the other buffer meanwhile. LVGL never starts a flush before the previous one reported
+// ready, so the worker holds at most one job.
+//
+// impls/common runs the framebuffer, the worker and _lvStep. The backend registers the LVGL display and
+// converts the rows of its draw buffer (the hooks below).
+
+/**
+ * @brief Bytes of one pixel in the draw buffer, lv_color_t in LVGL 8 and the display color format in LVGL 9
+ */
+static constexpr size_t kNativeBytesPerPixel = (LV_COLOR_DEPTH + 7) / 8;
+
+struct FlushJob
+{
+    lv_area_t area;
+    const uint8_t* pixels;
+    bool last;
+};
+
+struct HeadlessDisplay
+{
+    DisplayConfig config;
+    size_t bytesPerPixel = kNativeBytesPerPixel;
+    std::vector<uint8_t> framebuffer;
+    std::vector<uint8_t> drawBuffers[2];
+#if LVGL_VERSION_MAJOR >= 9
+    lv_display_t* disp = nullptr;
+#else
+    lv_disp_draw_buf_t drawBuf;
+    lv_disp_drv_t driver;
+    lv_disp_t* disp = nullptr;
+#endif
+    uint32_t frames = 0;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable cv;
+    FlushJob job{};
+    bool hasJob = false;
+    bool busy = false;
+    bool stopping = false;
+
+    PixelPath conversion = PixelPath::Scalar;
+    FlushStats stats;
+};
+
+/**
+ * @brief Body of the flush callback: copy the area now, or hand it to the worker if double buffered
+ */
+void headless_flush(HeadlessDisplay& display, const lv_area_t& area, const uint8_t* pixels, bool last);
+
+/**
+ * @brief Block until the worker has copied the last area, returns at once if single buffered
+ */
+void headless_wait_flushed(HeadlessDisplay& display);
+
+// ---------- Backend hooks ----------
+
+/**
+ * @brief Create the LVGL display for display.config with draw buffers of the given number of lines
+ * @note The flush callback calls headless_flush, the wait callback of a double buffered display
+ * headless_wait_flushed
+ */
+bool headless_register(HeadlessDisplay& display, uint32_t lines);
+
+void headless_unregister(HeadlessDisplay& display);
+
+/**
+ * @brief lv_disp_flush_ready, called from the worker thread when double buffered
+ */
+void headless_flush_ready(HeadlessDisplay& display);
+
+/**
+ * @brief Bytes from one row of a flushed area of the given width to the next in the draw buffer
+ */
+size_t headless_source_stride(const HeadlessDisplay& display, size_t width);
+
+/**
+ * @brief Convert one row of the draw buffer to the framebuffer format (PixelFormat::Rgb565)
+ */
+void headless_convert_row(const HeadlessDisplay& display, const uint8_t* src, uint8_t* dst, size_t count);
+
+} // namespace adaptor
+} // namespace gui
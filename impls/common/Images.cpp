@@ -0,0 +1,412 @@
+#include "AdaptorCommon.h"
+#include "EventDispatcher.h"
+#include "Recorder.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// --- Image Implementation ---
+lv_obj_t* _lvCreateImage(lv_obj_t* parent)
+{
+    return record_created(RecordOp::CreateImage, track_created(image_create(parent)), parent);
+}
+
+void _lvSetImageSrc(lv_obj_t* obj, const image_dsc_t* src)
+{
+    record_call(RecordOp::SetImageSrc, obj, src != nullptr);
+    image_set_src(obj, src);
+}
+
+// ==================== Image cache ====================
+// Images are decoded into memory descriptors once, LVGL then draws them like compiled-in images without
+// running a decoder at draw time. Which .bin formats and whether PNG files can be decoded depends on the
+// backend (decode_lvgl_bin, decode_png).
+
+static std::atomic<uint64_t> gImageDecodeFailures{0};
+
+static bool read_file(const char* path, std::vector<uint8_t>& out)
+{
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? std::ftell(file) : -1;
+    ok = size > 0 && std::fseek(file, 0, SEEK_SET) == 0;
+    if (ok) {
+        out.resize(static_cast<size_t>(size));
+        ok = std::fread(out.data(), 1, out.size(), file) == out.size();
+    }
+    std::fclose(file);
+    return ok;
+}
+
+static bool is_png(const std::vector<uint8_t>& file)
+{
+    static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    return file.size() >= sizeof(kSignature) && std::memcmp(file.data(), kSignature, sizeof(kSignature)) == 0;
+}
+
+class ImageCache
+{
+public:
+    static constexpr size_t kDefaultCapacityBytes = 4 * 1024 * 1024;
+
+    ImageRef lookup(const char* path)
+    {
+        auto it = mIndex.find(std::string_view(path));
+        if (it == mIndex.end()) {
+            ++mStats.misses;
+            return nullptr;
+        }
+        mLru.splice(mLru.begin(), mLru, it->second);
+        ++mStats.hits;
+        return it->second->image;
+    }
+
+    void insert(const char* path, ImageRef image)
+    {
+        size_t bytes = image->data.size();
+        if (bytes > mCapacityBytes) {
+            // Shown but never cached, it would evict everything else
+            return;
+        }
+        auto it = mIndex.find(std::string_view(path));
+        if (it != mIndex.end()) {
+            mBytes -= it->second->image->data.size();
+            it->second->image = std::move(image);
+            mBytes += bytes;
+            mLru.splice(mLru.begin(), mLru, it->second);
+        } else {
+            mLru.push_front(Entry{path, std::move(image)});
+            mIndex.emplace(std::string_view(mLru.front().path), mLru.begin());
+            mBytes += bytes;
+        }
+        _evict();
+    }
+
+    void setCapacity(size_t bytes)
+    {
+        mCapacityBytes = bytes;
+        _evict();
+    }
+
+    void recordFirstPixel(uint64_t us)
+    {
+        ++mStats.loads;
+        mStats.totalFirstPixelUs += us;
+        mStats.maxFirstPixelUs = std::max(mStats.maxFirstPixelUs, us);
+    }
+
+    ImageCacheStats stats() const
+    {
+        ImageCacheStats stats = mStats;
+        stats.failures = gImageDecodeFailures.load(std::memory_order_relaxed);
+        stats.entries = mLru.size();
+        stats.bytes = mBytes;
+        stats.capacityBytes = mCapacityBytes;
+        return stats;
+    }
+
+    void resetStats()
+    {
+        mStats = ImageCacheStats{};
+        gImageDecodeFailures.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry
+    {
+        std::string path;
+        ImageRef image;
+    };
+
+    void _evict()
+    {
+        while (mBytes > mCapacityBytes && !mLru.empty()) {
+            mBytes -= mLru.back().image->data.size();
+            mIndex.erase(std::string_view(mLru.back().path));
+            mLru.pop_back();
+            ++mStats.evictions;
+        }
+    }
+
+    std::list<Entry> mLru;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> mIndex;
+    size_t mBytes = 0;
+    size_t mCapacityBytes = kDefaultCapacityBytes;
+    ImageCacheStats mStats;
+};
+
+static ImageCache gImageCache;
+
+static void show_image(lv_obj_t* obj, const image_dsc_t* dsc, std::shared_ptr<const void> owner)
+{
+    image_set_src(obj, dsc);
+    // The cache may evict the image, or the pack be unmounted, while the object still draws it
+    EventDispatcher::instance().retain(obj, std::move(owner));
+}
+
+bool _lvShowCachedImage(lv_obj_t* obj, const char* path)
+{
+    record_call(RecordOp::ShowCachedImage, obj, path);
+    ImageRef image = gImageCache.lookup(path);
+    if (!image) {
+        return false;
+    }
+    // Supersede a load of another path still running for this object
+    EventDispatcher::instance().request(obj);
+    const image_dsc_t* dsc = &image->dsc;
+    show_image(obj, dsc, std::move(image));
+    return true;
+}
+
+ImageTicket _lvBeginImageLoad(lv_obj_t* obj)
+{
+    ImageTicket ticket = EventDispatcher::instance().request(obj);
+    ticket.startUs = steady_us();
+    record_call(RecordOp::BeginImageLoad, obj, ticket);
+    return ticket;
+}
+
+ImageRef _lvDecodeImage(const char* path)
+{
+    std::vector<uint8_t> file;
+    std::shared_ptr<DecodedImage> image;
+    if (path && read_file(path, file)) {
+        image = is_png(file) ? decode_png(file) : decode_lvgl_bin(file);
+    }
+    if (!image) {
+        gImageDecodeFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+    return image;
+}
+
+bool _lvFinishImageLoad(const ImageTicket& ticket, const char* path, ImageRef image)
+{
+    record_call(RecordOp::FinishImageLoad, ticket, path, image != nullptr);
+    if (!image) {
+        return false;
+    }
+    gImageCache.insert(path, image);
+
+    lv_obj_t* obj = EventDispatcher::instance().resolve(ticket);
+    if (!obj) {
+        return false;
+    }
+    const image_dsc_t* dsc = &image->dsc;
+    show_image(obj, dsc, std::move(image));
+    gImageCache.recordFirstPixel(steady_us() - ticket.startUs);
+    return true;
+}
+
+void _lvSetImageCacheCapacity(size_t bytes)
+{
+    record_call(RecordOp::SetImageCacheCapacity, bytes);
+    gImageCache.setCapacity(bytes);
+}
+
+ImageCacheStats _lvGetImageCacheStats()
+{
+    return gImageCache.stats();
+}
+
+void _lvResetImageCacheStats()
+{
+    gImageCache.resetStats();
+}
+
+// ==================== Asset packs ====================
+// The pack is mapped and its entries are read in place, the backend checks the header and describes each image
+// in the descriptor of its LVGL version (asset_pack_matches, describe_packed_image).
+
+class MappedAssetPack
+{
+public:
+    ~MappedAssetPack()
+    {
+        if (mBase != MAP_FAILED) {
+            munmap(mBase, mSize);
+        }
+    }
+
+    bool map(const char* path)
+    {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            mSize = static_cast<size_t>(st.st_size);
+            mBase = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        // The mapping stays valid without the descriptor
+        close(fd);
+        return mBase != MAP_FAILED && _index();
+    }
+
+    const image_dsc_t* find(const char* name) const
+    {
+        auto it = std::lower_bound(mEntries, mEntries + mImages.size(), name,
+                                   [](const AssetPackEntry& entry, const char* key) {
+                                       return std::strcmp(entry.name, key) < 0;
+                                   });
+        if (it == mEntries + mImages.size() || std::strcmp(it->name, name) != 0) {
+            return nullptr;
+        }
+        const image_dsc_t& dsc = mImages[static_cast<size_t>(it - mEntries)];
+        return dsc.data ? &dsc : nullptr;
+    }
+
+    size_t size() const { return mSize; }
+    size_t images() const { return mImages.size(); }
+
+private:
+    bool _index()
+    {
+        const auto* base = static_cast<const uint8_t*>(mBase);
+        AssetPackHeader header;
+        if (mSize < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, base, sizeof(header));
+        if (header.magic != kAssetPackMagic || header.version != kAssetPackVersion ||
+            !asset_pack_matches(header) || header.count > (mSize - sizeof(header)) / sizeof(AssetPackEntry)) {
+            return false;
+        }
+
+        // The header keeps the entries aligned, they are read in place
+        mEntries = reinterpret_cast<const AssetPackEntry*>(base + sizeof(header));
+        mImages.resize(header.count);
+        for (uint32_t i = 0; i < header.count; ++i) {
+            const AssetPackEntry& entry = mEntries[i];
+            if (!std::memchr(entry.name, 0, sizeof(entry.name)) || entry.offset % kAssetPackAlignment != 0 ||
+                entry.offset > mSize || entry.size > mSize - entry.offset) {
+                return false;
+            }
+            if (!describe_packed_image(header, entry, base, mImages[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void* mBase = MAP_FAILED;
+    size_t mSize = 0;
+    const AssetPackEntry* mEntries = nullptr;
+    std::vector<image_dsc_t> mImages;
+};
+
+struct AssetPacks
+{
+    std::vector<std::shared_ptr<const MappedAssetPack>> mounted;
+    AssetPackStats stats;
+};
+
+static AssetPacks gAssetPacks;
+
+static std::shared_ptr<const MappedAssetPack> map_asset_pack(const char* path)
+{
+    auto pack = std::make_shared<MappedAssetPack>();
+    if (!path || !pack->map(path)) {
+        return nullptr;
+    }
+    return pack;
+}
+
+int _lvMountAssetPack(const char* path)
+{
+    record_call(RecordOp::MountAssetPack, path);
+    uint64_t start = steady_us();
+    auto pack = map_asset_pack(path);
+    if (!pack) {
+        return -1;
+    }
+    gAssetPacks.stats.mountUs += steady_us() - start;
+    gAssetPacks.stats.mappedBytes += pack->size();
+    gAssetPacks.stats.images += static_cast<uint32_t>(pack->images());
+    ++gAssetPacks.stats.packs;
+    gAssetPacks.mounted.push_back(std::move(pack));
+    return 0;
+}
+
+void _lvUnmountAssetPacks()
+{
+    record_call(RecordOp::UnmountAssetPacks);
+    gAssetPacks = AssetPacks{};
+}
+
+bool _lvShowPackedImage(lv_obj_t* obj, const char* name)
+{
+    record_call(RecordOp::ShowPackedImage, obj, name);
+    if (gAssetPacks.mounted.empty()) {
+        return false;
+    }
+    for (const auto& pack : gAssetPacks.mounted) {
+        if (const image_dsc_t* dsc = pack->find(name)) {
+            ++gAssetPacks.stats.hits;
+            EventDispatcher::instance().request(obj);
+            show_image(obj, dsc, pack);
+            return true;
+        }
+    }
+    ++gAssetPacks.stats.misses;
+    return false;
+}
+
+AssetPackStats _lvGetAssetPackStats()
+{
+    return gAssetPacks.stats;
+}
+
+AssetLoadBenchmark _lvBenchmarkAssetLoad(const char* packPath, const std::vector<std::string>& files)
+{
+    AssetLoadBenchmark result;
+    volatile uint8_t sink = 0;
+
+    uint64_t start = steady_us();
+    if (auto pack = map_asset_pack(packPath)) {
+        for (const std::string& file : files) {
+            const image_dsc_t* dsc = pack->find(file.c_str());
+            if (!dsc) {
+                continue;
+            }
+            // Fault in every page like the first draw would
+            for (uint32_t offset = 0; offset < dsc->data_size; offset += 4096) {
+                sink = sink + dsc->data[offset];
+            }
+            ++result.images;
+        }
+    }
+    result.packUs = steady_us() - start;
+
+    start = steady_us();
+    for (const std::string& file : files) {
+        ImageRef image = _lvDecodeImage(file.c_str());
+        if (image && !image->data.empty()) {
+            sink = sink + image->data[0];
+        }
+    }
+    result.filesUs = steady_us() - start;
+    return result;
+}
+
+} // namespace adaptor
+} // namespace gui
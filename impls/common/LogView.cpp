@@ -0,0 +1,300 @@
+#include "AdaptorCommon.h"
+#include "EventDispatcher.h"
+#include "Recorder.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Log view ====================
+// LVGL scrolls over a range of lines (mBase up to at most LV_COORD_MAX / 2 of height), which the object reports
+// as its content size (LV_EVENT_GET_SELF_SIZE), and only the rows in view exist. When the view scrolls close to
+// an edge of the range the range moves so the view is in its middle again, and the scroll position moves by
+// the same height: the lines on screen stay put and every line of the log can be reached, however long it is.
+// The scrollbar shows the position in the range. Line i is shown by row i % rows, scrolling by one line
+// re-renders one row and the others keep their text.
+
+class LogViewState
+{
+public:
+    explicit LogViewState(lv_obj_t* obj) : mObj(obj) {}
+
+    void setSource(std::function<const char*(size_t)> line)
+    {
+        mLine = std::move(line);
+        _invalidateRows();
+        refresh();
+    }
+
+    void setAutoScroll(bool isEnabled)
+    {
+        mAutoScroll = isEnabled;
+        mFollow = isEnabled;
+        if (mFollow) {
+            _scrollToBottom();
+        }
+    }
+
+    void update(size_t count, size_t dropped)
+    {
+        ++mStats.updates;
+        uint64_t baseBefore = mFirstSequence + mBase;
+        mCount = count;
+        mFirstSequence += dropped;
+        // The base stays on its line unless that line was dropped or the range would pass the end
+        mBase = mBase > dropped ? mBase - dropped : 0;
+        _clampBase();
+        lv_obj_refresh_self_size(mObj);
+
+        if (mFollow) {
+            _scrollToBottom();
+        } else {
+            // Keep the lines in view where they are while the range moves, lines that were dropped scroll out
+            auto moved = static_cast<int64_t>(mFirstSequence + mBase - baseBefore);
+            int64_t shift = moved * _rowHeight();
+            if (shift > 0) {
+                shift = std::min<int64_t>(shift, std::max<coord_t>(lv_obj_get_scroll_y(mObj), 0));
+            }
+            _scrollBy(static_cast<coord_t>(shift));
+            _recentre();
+        }
+        refresh();
+    }
+
+    void onEvent(lv_event_t* e)
+    {
+        switch (lv_event_get_code(e)) {
+            case LV_EVENT_GET_SELF_SIZE: {
+                auto* size = static_cast<lv_point_t*>(lv_event_get_param(e));
+                size->y = std::max(size->y, _contentHeight());
+            }
+            break;
+            case LV_EVENT_SCROLL:
+                if (!mScrolling) {
+                    _recentre();
+                }
+                refresh();
+                break;
+            case LV_EVENT_SCROLL_END:
+                if (!mScrolling && mAutoScroll) {
+                    // Scrolling back to the bottom resumes following
+                    mFollow = mBase + _rangeLines() == mCount && lv_obj_get_scroll_bottom(mObj) < _rowHeight();
+                }
+                break;
+            case LV_EVENT_SIZE_CHANGED:
+            case LV_EVENT_STYLE_CHANGED:
+                mRowHeight = 0;
+                _invalidateRows();
+                _clampBase();
+                if (mFollow) {
+                    _scrollToBottom();
+                }
+                refresh();
+                break;
+            default:
+                break;
+        }
+    }
+
+    void refresh()
+    {
+        _ensureRows();
+        if (mRows.empty()) {
+            return;
+        }
+
+        coord_t rowHeight = _rowHeight();
+        coord_t top = std::max<coord_t>(lv_obj_get_scroll_y(mObj), 0);
+        size_t first = static_cast<size_t>(top / rowHeight);
+        size_t rangeLines = _rangeLines();
+        // i is the position in the range, the row at i shows line mBase + i
+        for (size_t i = first; i < first + mRows.size(); ++i) {
+            uint64_t sequence = mFirstSequence + mBase + i;
+            size_t slot = static_cast<size_t>(sequence % mRows.size());
+            lv_obj_t* row = mRows[slot];
+            if (i >= rangeLines || !mLine) {
+                lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+                mRowSequence[slot] = kNoLine;
+                continue;
+            }
+            if (mRowSequence[slot] != sequence) {
+                mRowSequence[slot] = sequence;
+                lv_label_set_text(row, mLine(mBase + i));
+                ++mStats.rowsRefreshed;
+            }
+            lv_obj_set_y(row, static_cast<coord_t>(i * rowHeight));
+            obj_remove_flag(row, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    LogViewStats stats() const
+    {
+        LogViewStats stats = mStats;
+        stats.rows = static_cast<uint32_t>(mRows.size());
+        return stats;
+    }
+
+private:
+    static constexpr uint64_t kNoLine = UINT64_MAX;
+
+    coord_t _rowHeight()
+    {
+        if (mRowHeight <= 0) {
+            const lv_font_t* font = lv_obj_get_style_text_font(mObj, LV_PART_MAIN);
+            mRowHeight = lv_font_get_line_height(font) + lv_obj_get_style_text_line_space(mObj, LV_PART_MAIN);
+            mRowHeight = std::max<coord_t>(mRowHeight, 1);
+        }
+        return mRowHeight;
+    }
+
+    void _ensureRows()
+    {
+        coord_t height = lv_obj_get_content_height(mObj);
+        // One spare row for the partly visible line at each edge
+        size_t needed = height > 0 ? static_cast<size_t>(height / _rowHeight()) + 2 : 0;
+        while (mRows.size() < needed) {
+            lv_obj_t* row = lv_label_create(mObj);
+            lv_label_set_long_mode(row, LV_LABEL_LONG_CLIP);
+            lv_obj_set_width(row, lv_pct(100));
+            lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+            mRows.push_back(row);
+            _invalidateRows();
+        }
+        while (mRows.size() > needed) {
+            obj_delete(mRows.back());
+            mRows.pop_back();
+            _invalidateRows();
+        }
+    }
+
+    void _invalidateRows()
+    {
+        // The line to row mapping depends on the number of rows
+        mRowSequence.assign(mRows.size(), kNoLine);
+    }
+
+    size_t _rangeLines()
+    {
+        // Half the coordinate range, the padding and the view height are added to the content height
+        return std::min<size_t>(mCount, static_cast<size_t>(LV_COORD_MAX / 2 / _rowHeight()));
+    }
+
+    void _clampBase()
+    {
+        mBase = std::min(mBase, mCount - _rangeLines());
+    }
+
+    coord_t _contentHeight()
+    {
+        return static_cast<coord_t>(_rangeLines() * _rowHeight());
+    }
+
+    /**
+     * @brief Move the range so the view is in its middle, if the view came close to an edge of it
+     */
+    void _recentre()
+    {
+        size_t rangeLines = _rangeLines();
+        if (rangeLines == mCount) {
+            return;
+        }
+        coord_t rowHeight = _rowHeight();
+        size_t top = static_cast<size_t>(std::max<coord_t>(lv_obj_get_scroll_y(mObj), 0) / rowHeight);
+        size_t visible = std::min(static_cast<size_t>(lv_obj_get_content_height(mObj) / rowHeight) + 1, rangeLines);
+        size_t margin = (rangeLines - visible) / 4;
+        bool nearTop = top < margin && mBase > 0;
+        bool nearBottom = top + visible + margin > rangeLines && mBase + rangeLines < mCount;
+        if (!nearTop && !nearBottom) {
+            return;
+        }
+
+        size_t line = mBase + top;
+        size_t above = (rangeLines - visible) / 2;
+        size_t base = std::min(line > above ? line - above : 0, mCount - rangeLines);
+        auto moved = static_cast<int64_t>(base) - static_cast<int64_t>(mBase);
+        mBase = base;
+        _scrollBy(static_cast<coord_t>(moved * rowHeight));
+    }
+
+    void _scrollToBottom()
+    {
+        mBase = mCount - _rangeLines();
+        coord_t target = std::max<coord_t>(_contentHeight() - lv_obj_get_content_height(mObj), 0);
+        _scrollBy(lv_obj_get_scroll_y(mObj) - target);
+    }
+
+    void _scrollBy(coord_t dy)
+    {
+        if (dy == 0) {
+            return;
+        }
+        mScrolling = true;
+        lv_obj_scroll_by(mObj, 0, dy, LV_ANIM_OFF);
+        mScrolling = false;
+    }
+
+    lv_obj_t* mObj;
+    std::function<const char*(size_t)> mLine;
+    size_t mCount = 0;
+    size_t mBase = 0;                   ///< Line at the top of the range LVGL scrolls over
+    uint64_t mFirstSequence = 0;
+    coord_t mRowHeight = 0;
+    bool mAutoScroll = true;
+    bool mFollow = true;
+    bool mScrolling = false;
+    std::vector<lv_obj_t*> mRows;
+    std::vector<uint64_t> mRowSequence;
+    LogViewStats mStats;
+};
+
+static LogViewState* log_view_state(lv_obj_t* obj)
+{
+    return static_cast<LogViewState*>(lv_obj_get_user_data(obj));
+}
+
+lv_obj_t* _lvCreateLogView(lv_obj_t* parent)
+{
+    lv_obj_t* obj = track_created(lv_obj_create(parent));
+    lv_obj_set_scroll_dir(obj, LV_DIR_VER);
+
+    // Owned by the handler, released with it when the object is deleted
+    auto state = std::make_shared<LogViewState>(obj);
+    lv_obj_set_user_data(obj, state.get());
+    auto handler = std::function<void(lv_event_t*)>([state](lv_event_t* e) { state->onEvent(e); });
+    auto& dispatcher = EventDispatcher::instance();
+    for (lv_event_code_t code : {LV_EVENT_GET_SELF_SIZE, LV_EVENT_SCROLL, LV_EVENT_SCROLL_END,
+                                 LV_EVENT_SIZE_CHANGED, LV_EVENT_STYLE_CHANGED}) {
+        dispatcher.add(obj, code, EventArg::Event, handler);
+    }
+    return record_created(RecordOp::CreateLogView, obj, parent);
+}
+
+void _lvSetLogViewSource(lv_obj_t* obj, std::function<const char*(size_t)> line)
+{
+    record_call(RecordOp::SetLogViewSource, obj);
+    log_view_state(obj)->setSource(record_log_source(obj, std::move(line)));
+}
+
+void _lvUpdateLogView(lv_obj_t* obj, size_t count, size_t dropped)
+{
+    record_call(RecordOp::UpdateLogView, obj, count, dropped);
+    log_view_state(obj)->update(count, dropped);
+}
+
+void _lvSetLogViewAutoScroll(lv_obj_t* obj, bool isEnabled)
+{
+    record_call(RecordOp::SetLogViewAutoScroll, obj, isEnabled);
+    log_view_state(obj)->setAutoScroll(isEnabled);
+}
+
+LogViewStats _lvGetLogViewStats(lv_obj_t* obj)
+{
+    return log_view_state(obj)->stats();
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,250 @@
+#pragma once
+
+#include "../../iface/gui/style/Color.h"
+
+#include <lvgl.h>
+#if LVGL_VERSION_MAJOR >= 9
+#include <lvgl_private.h>
+#endif
+
+#include <cstdint>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== LVGL 8 / 9 compatibility ====================
+// The code under impls/common is written once against these shims. They only cover calls LVGL 9 renamed or
+// changed the signature of, what differs in behavior (display driver, image formats) stays in impls/lv8 and
+// impls/lv9.
+
+#if LVGL_VERSION_MAJOR >= 9
+using coord_t = int32_t;
+using image_dsc_t = lv_image_dsc_t;
+static constexpr lv_result_t kResultOk = LV_RESULT_OK;
+#else
+using coord_t = lv_coord_t;
+using image_dsc_t = lv_img_dsc_t;
+static constexpr lv_res_t kResultOk = LV_RES_OK;
+#endif
+
+inline void obj_remove_flag(lv_obj_t* obj, lv_obj_flag_t flag)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_remove_flag(obj, flag);
+#else
+    lv_obj_clear_flag(obj, flag);
+#endif
+}
+
+inline void obj_remove_state(lv_obj_t* obj, lv_state_t state)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_remove_state(obj, state);
+#else
+    lv_obj_clear_state(obj, state);
+#endif
+}
+
+inline void obj_delete(lv_obj_t* obj)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_delete(obj);
+#else
+    lv_obj_del(obj);
+#endif
+}
+
+inline uint32_t child_count(lv_obj_t* obj)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return lv_obj_get_child_count(obj);
+#else
+    return lv_obj_get_child_cnt(obj);
+#endif
+}
+
+inline void timer_delete(lv_timer_t* timer)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_timer_delete(timer);
+#else
+    lv_timer_del(timer);
+#endif
+}
+
+inline void* timer_user_data(lv_timer_t* timer)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return lv_timer_get_user_data(timer);
+#else
+    return timer->user_data;
+#endif
+}
+
+/**
+ * @brief Refresh period of the display of obj, of the default display for nullptr
+ */
+inline uint32_t refresh_period(lv_obj_t* obj = nullptr)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_display_t* disp = obj ? lv_obj_get_display(obj) : lv_display_get_default();
+    lv_timer_t* refresh = disp ? lv_display_get_refr_timer(disp) : nullptr;
+    return refresh ? refresh->period : LV_DEF_REFR_PERIOD;
+#else
+    lv_disp_t* disp = obj ? lv_obj_get_disp(obj) : lv_disp_get_default();
+    return disp && disp->refr_timer ? disp->refr_timer->period : LV_DISP_DEF_REFR_PERIOD;
+#endif
+}
+
+inline lv_obj_t* event_target(lv_event_t* e)
+{
+    return static_cast<lv_obj_t*>(lv_event_get_target(e));
+}
+
+inline void send_event(lv_obj_t* obj, lv_event_code_t code, void* param)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_send_event(obj, code, param);
+#else
+    lv_event_send(obj, code, param);
+#endif
+}
+
+/**
+ * @brief User data obj registered cb with, nullptr if it did not
+ */
+inline void* event_user_data(lv_obj_t* obj, lv_event_cb_t cb)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    // LVGL 9 has no lookup by callback, the descriptors of the object are searched
+    uint32_t count = lv_obj_get_event_count(obj);
+    for (uint32_t i = 0; i < count; ++i) {
+        lv_event_dsc_t* dsc = lv_obj_get_event_dsc(obj, i);
+        if (lv_event_dsc_get_cb(dsc) == cb) {
+            return lv_event_dsc_get_user_data(dsc);
+        }
+    }
+    return nullptr;
+#else
+    return lv_obj_get_event_user_data(obj, cb);
+#endif
+}
+
+inline void text_get_size(lv_point_t* size, const char* text, const lv_font_t* font, coord_t letterSpace,
+                          coord_t lineSpace, coord_t maxWidth, lv_text_flag_t flags)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_text_get_size(size, text, font, letterSpace, lineSpace, maxWidth, flags);
+#else
+    lv_txt_get_size(size, text, font, letterSpace, lineSpace, maxWidth, flags);
+#endif
+}
+
+inline lv_obj_t* button_create(lv_obj_t* parent)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return lv_button_create(parent);
+#else
+    return lv_btn_create(parent);
+#endif
+}
+
+inline lv_obj_t* list_add_button(lv_obj_t* list, const char* text)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return lv_list_add_button(list, nullptr, text);
+#else
+    return lv_list_add_btn(list, nullptr, text);
+#endif
+}
+
+inline const char* list_button_text(lv_obj_t* list, lv_obj_t* button)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return lv_list_get_button_text(list, button);
+#else
+    return lv_list_get_btn_text(list, button);
+#endif
+}
+
+inline lv_obj_t* spinner_create(lv_obj_t* parent, uint32_t timeMs, uint32_t arcAngle)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_t* spinner = lv_spinner_create(parent);
+    lv_spinner_set_anim_params(spinner, timeMs, arcAngle);
+    return spinner;
+#else
+    return lv_spinner_create(parent, timeMs, arcAngle);
+#endif
+}
+
+inline lv_obj_t* image_create(lv_obj_t* parent)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return lv_image_create(parent);
+#else
+    return lv_img_create(parent);
+#endif
+}
+
+inline void image_set_src(lv_obj_t* obj, const image_dsc_t* src)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_image_set_src(obj, src);
+#else
+    lv_img_set_src(obj, src);
+#endif
+}
+
+/**
+ * @brief Square size of the part, the point markers of a chart
+ */
+inline void set_style_square_size(lv_obj_t* obj, coord_t size, lv_style_selector_t selector)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    lv_obj_set_style_size(obj, size, size, selector);
+#else
+    lv_obj_set_style_size(obj, size, selector);
+#endif
+}
+
+// ==================== Color conversion ====================
+// style::Color is 0xAARRGGBB. The RGB part maps to lv_color_t in a constant expression, so a constant color costs
+// nothing at runtime: LVGL 8 converts to the configured LV_COLOR_DEPTH, LVGL 9 keeps colors as RGB888 whatever
+// the display format. The alpha byte goes to the matching *_opa style.
+
+constexpr lv_color_t to_lv_color(gui::style::Color color)
+{
+    return LV_COLOR_MAKE(color.red(), color.green(), color.blue());
+}
+
+constexpr lv_opa_t to_lv_opa(gui::style::Color color)
+{
+    return color.alpha();
+}
+
+/**
+ * @brief Opaque style::Color of an lv_color_t, LVGL 8 scales a lower color depth up to 8 bits per channel
+ */
+inline gui::style::Color from_lv_color(lv_color_t color)
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return gui::style::Color{lv_color_to_u32(color) | 0xFF000000u};
+#else
+    return gui::style::Color{lv_color_to32(color) | 0xFF000000u};
+#endif
+}
+
+#if LVGL_VERSION_MAJOR >= 9
+static_assert(to_lv_color(gui::style::Color{gui::style::Color::Danger}).red == 0xE1,
+              "Color conversion has to be a constant expression matching lv_color_hex");
+#elif LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+static_assert(to_lv_color(gui::style::Color{gui::style::Color::Danger}).ch.red == 0xE1 >> 3,
+              "Color conversion has to be a constant expression matching lv_color_hex");
+#elif LV_COLOR_DEPTH == 32
+static_assert(to_lv_color(gui::style::Color{gui::style::Color::Danger}).ch.red == 0xE1,
+              "Color conversion has to be a constant expression matching lv_color_hex");
+#endif
+
+} // namespace adaptor
+} // namespace gui
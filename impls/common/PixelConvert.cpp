@@ -0,0 +1,181 @@
+#include "PixelConvert.h"
+
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PIXEL_CONVERT_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PIXEL_CONVERT_NEON 1
+#endif
+
+namespace gui {
+namespace adaptor {
+
+static inline uint16_t to_rgb565(uint32_t argb)
+{
+    return static_cast<uint16_t>(((argb >> 8) & 0xF800) | ((argb >> 5) & 0x07E0) | ((argb >> 3) & 0x001F));
+}
+
+static void convert_scalar(const uint32_t* src, uint16_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = to_rgb565(src[i]);
+    }
+}
+
+#if PIXEL_CONVERT_X86 && defined(__SSE2__)
+static inline __m128i rgb565_lanes_sse2(__m128i argb)
+{
+    const __m128i maskR = _mm_set1_epi32(0xF800);
+    const __m128i maskG = _mm_set1_epi32(0x07E0);
+    const __m128i maskB = _mm_set1_epi32(0x001F);
+    __m128i r = _mm_and_si128(_mm_srli_epi32(argb, 8), maskR);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(argb, 5), maskG);
+    __m128i b = _mm_and_si128(_mm_srli_epi32(argb, 3), maskB);
+    // Sign extend the low half so the saturating pack keeps the bits as they are
+    __m128i rgb = _mm_or_si128(_mm_or_si128(r, g), b);
+    return _mm_srai_epi32(_mm_slli_epi32(rgb, 16), 16);
+}
+
+static void convert_sse2(const uint32_t* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = rgb565_lanes_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        __m128i hi = rgb565_lanes_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+    }
+    convert_scalar(src + i, dst + i, count - i);
+}
+#endif
+
+#if PIXEL_CONVERT_X86 && defined(__GNUC__)
+__attribute__((target("avx2"))) static inline __m256i rgb565_lanes_avx2(__m256i argb)
+{
+    const __m256i maskR = _mm256_set1_epi32(0xF800);
+    const __m256i maskG = _mm256_set1_epi32(0x07E0);
+    const __m256i maskB = _mm256_set1_epi32(0x001F);
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(argb, 8), maskR);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(argb, 5), maskG);
+    __m256i b = _mm256_and_si256(_mm256_srli_epi32(argb, 3), maskB);
+    __m256i rgb = _mm256_or_si256(_mm256_or_si256(r, g), b);
+    return _mm256_srai_epi32(_mm256_slli_epi32(rgb, 16), 16);
+}
+
+__attribute__((target("avx2"))) static void convert_avx2(const uint32_t* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i lo = rgb565_lanes_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+        __m256i hi = rgb565_lanes_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 8)));
+        // The pack works per 128 bit lane, restore the pixel order across the lanes
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    convert_scalar(src + i, dst + i, count - i);
+}
+#endif
+
+#if PIXEL_CONVERT_NEON
+static void convert_neon(const uint32_t* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        // Deinterleave 16 pixels into the B, G, R and A planes
+        uint8x16x4_t px = vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+        uint8x16_t r = vandq_u8(px.val[2], vdupq_n_u8(0xF8));
+        uint8x16_t g = vandq_u8(px.val[1], vdupq_n_u8(0xFC));
+        uint8x16_t b = vshrq_n_u8(px.val[0], 3);
+
+        uint16x8_t lo = vorrq_u16(vorrq_u16(vshll_n_u8(vget_low_u8(r), 8), vshll_n_u8(vget_low_u8(g), 3)),
+                                  vmovl_u8(vget_low_u8(b)));
+        uint16x8_t hi = vorrq_u16(vorrq_u16(vshll_n_u8(vget_high_u8(r), 8), vshll_n_u8(vget_high_u8(g), 3)),
+                                  vmovl_u8(vget_high_u8(b)));
+        vst1q_u16(dst + i, lo);
+        vst1q_u16(dst + i + 8, hi);
+    }
+    convert_scalar(src + i, dst + i, count - i);
+}
+#endif
+
+const char* to_string(PixelPath path)
+{
+    switch (path) {
+        case PixelPath::Scalar: return "scalar";
+        case PixelPath::Sse2: return "sse2";
+        case PixelPath::Avx2: return "avx2";
+        case PixelPath::Neon: return "neon";
+    }
+    return "unknown";
+}
+
+bool pixel_path_supported(PixelPath path)
+{
+    switch (path) {
+        case PixelPath::Scalar:
+            return true;
+        case PixelPath::Sse2:
+#if PIXEL_CONVERT_X86 && defined(__SSE2__)
+            return true;
+#else
+            return false;
+#endif
+        case PixelPath::Avx2:
+#if PIXEL_CONVERT_X86 && defined(__GNUC__)
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+        case PixelPath::Neon:
+#if PIXEL_CONVERT_NEON
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+PixelPath best_pixel_path()
+{
+    static const PixelPath sBest = [] {
+        for (PixelPath path : {PixelPath::Avx2, PixelPath::Neon, PixelPath::Sse2}) {
+            if (pixel_path_supported(path)) {
+                return path;
+            }
+        }
+        return PixelPath::Scalar;
+    }();
+    return sBest;
+}
+
+void convert_argb8888_to_rgb565(const uint32_t* src, uint16_t* dst, size_t count, PixelPath path)
+{
+    switch (path) {
+#if PIXEL_CONVERT_X86 && defined(__SSE2__)
+        case PixelPath::Sse2:
+            convert_sse2(src, dst, count);
+            return;
+#endif
+#if PIXEL_CONVERT_X86 && defined(__GNUC__)
+        case PixelPath::Avx2:
+            convert_avx2(src, dst, count);
+            return;
+#endif
+#if PIXEL_CONVERT_NEON
+        case PixelPath::Neon:
+            convert_neon(src, dst, count);
+            return;
+#endif
+        default:
+            convert_scalar(src, dst, count);
+            return;
+    }
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Pixel conversion ====================
+// Row conversion for the display flush, independent of LVGL. Every path produces the same output as
+// the scalar one, i.e. the channels are truncated like LVGL's own 32 to 16 bit conversion.
+
+enum class PixelPath : uint8_t {
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon
+};
+
+const char* to_string(PixelPath path);
+
+/**
+ * @brief Whether the path is compiled in and the CPU supports it
+ */
+bool pixel_path_supported(PixelPath path);
+
+/**
+ * @brief Fastest supported path, detected once
+ */
+PixelPath best_pixel_path();
+
+/**
+ * @brief Convert pixels from 0xAARRGGBB (LV_COLOR_DEPTH 32) to RGB565
+ * @param[in] path Path to use, has to be supported
+ */
+void convert_argb8888_to_rgb565(const uint32_t* src, uint16_t* dst, size_t count, PixelPath path);
+
+inline void convert_argb8888_to_rgb565(const uint32_t* src, uint16_t* dst, size_t count)
+{
+    convert_argb8888_to_rgb565(src, dst, count, best_pixel_path());
+}
+
+} // namespace adaptor
+} // namespace gui
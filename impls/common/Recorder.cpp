@@ -0,0 +1,272 @@
+#include "Recorder.h"
+#include "LvCompat.h"
+
+#include <cstring>
+
+namespace gui {
+namespace adaptor {
+
+static constexpr size_t kRecordFlushBytes = 64 * 1024;
+
+std::unique_ptr<CallRecorder> gCallRecorder;
+static RecordingStats gFinishedRecording;
+
+static void recorded_delete_cb(lv_event_t* e)
+{
+    if (gCallRecorder) {
+        gCallRecorder->forget(event_target(e));
+    }
+}
+
+CallRecorder::CallRecorder(FILE* file)
+    : mFile(file), mLast(std::chrono::steady_clock::now())
+{
+    mBuffer.reserve(kRecordFlushBytes + 256);
+    mBuffer.insert(mBuffer.end(), std::begin(kRecordMagic), std::end(kRecordMagic));
+    mBuffer.push_back(kRecordVersion);
+}
+
+CallRecorder::~CallRecorder()
+{
+    finish();
+}
+
+RecordingStats CallRecorder::finish()
+{
+    // The objects still alive outlive the recording, their delete hooks go with it
+    for (const auto& entry : mIds) {
+        lv_obj_remove_event_cb(const_cast<lv_obj_t*>(entry.first), recorded_delete_cb);
+    }
+    mIds.clear();
+    mSeries.clear();
+    if (mFile) {
+        write();
+    }
+    if (mFile) {
+        // fclose writes what stdio still buffers
+        mStats.failed = fclose(mFile) != 0 || mStats.failed;
+        mFile = nullptr;
+    }
+    return mStats;
+}
+
+void CallRecorder::write()
+{
+    if (mBuffer.empty()) return;
+
+    size_t written = fwrite(mBuffer.data(), 1, mBuffer.size(), mFile);
+    mStats.bytes += written;
+    if (written < mBuffer.size()) {
+        // Disk full or similar, a log with a hole would not replay, it ends after the last complete write
+        mStats.failed = true;
+        fclose(mFile);
+        mFile = nullptr;
+    }
+    mBuffer.clear();
+}
+
+void CallRecorder::begin(RecordOp op)
+{
+    auto now = std::chrono::steady_clock::now();
+    putVarint(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - mLast).count()));
+    // Only the whole microseconds are consumed, the remainder carries over to the next delta
+    mLast += std::chrono::duration_cast<std::chrono::microseconds>(now - mLast);
+    mBuffer.push_back(static_cast<uint8_t>(op));
+}
+
+void CallRecorder::end()
+{
+    if (!mFile) {
+        // A failed write stopped the recording, later calls are dropped
+        mBuffer.clear();
+        return;
+    }
+    ++mStats.calls;
+    if (mBuffer.size() >= kRecordFlushBytes) {
+        write();
+    }
+}
+
+uint32_t CallRecorder::assignId(lv_obj_t* obj)
+{
+    uint32_t id = mNextId++;
+    mIds[obj] = id;
+    mSeries.erase(obj);
+    lv_obj_add_event_cb(obj, recorded_delete_cb, LV_EVENT_DELETE, nullptr);
+    ++mStats.objects;
+    return id;
+}
+
+void CallRecorder::destroyed(lv_obj_t* obj)
+{
+    begin(RecordOp::DestroyObj);
+    put(obj);
+    end();
+}
+
+void CallRecorder::forget(const lv_obj_t* obj)
+{
+    mIds.erase(obj);
+    mSeries.erase(obj);
+}
+
+void CallRecorder::chartSamples(lv_obj_t* obj, uint32_t series, const float* values, size_t count)
+{
+    begin(RecordOp::ChartSamples);
+    put(obj);
+    putVarint(series);
+    putVarint(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        putFixed32(bits);
+    }
+    end();
+}
+
+void CallRecorder::logViewLine(lv_obj_t* obj, const char* text)
+{
+    begin(RecordOp::LogViewLine);
+    put(obj);
+    put(text);
+    end();
+}
+
+void CallRecorder::putVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        mBuffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    mBuffer.push_back(static_cast<uint8_t>(value));
+}
+
+void CallRecorder::putFixed32(uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8) {
+        mBuffer.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+void CallRecorder::put(lv_obj_t* obj)
+{
+    auto it = mIds.find(obj);
+    putVarint(it != mIds.end() ? it->second : 0);
+}
+
+void CallRecorder::put(const char* text)
+{
+    if (!text) {
+        putVarint(0);
+        return;
+    }
+    size_t length = std::strlen(text);
+    putVarint(length + 1);
+    mBuffer.insert(mBuffer.end(), text, text + length);
+}
+
+void CallRecorder::put(const style::StackLayout& layout)
+{
+    put(layout.axis);
+    put(int32_t(layout.spacing));
+    put(int32_t(layout.padding));
+    put(layout.crossAlign);
+}
+
+void CallRecorder::put(const style::Theme& theme)
+{
+    // Fonts are pointers into the application, a replay keeps the fonts of the theme in effect
+    putVarint(theme.colors.size());
+    for (const auto& color : theme.colors) {
+        put(color);
+    }
+    putVarint(theme.spacing.size());
+    for (int16_t space : theme.spacing) {
+        put(int32_t(space));
+    }
+    putVarint(theme.radius.size());
+    for (int16_t radius : theme.radius) {
+        put(int32_t(radius));
+    }
+}
+
+void CallRecorder::put(const EventPolicy& policy)
+{
+    put(policy.mode);
+    putVarint(policy.intervalMs);
+    put(policy.leading);
+    put(policy.trailing);
+}
+
+void CallRecorder::put(const ImageTicket& ticket)
+{
+    putVarint(ticket.slot);
+    putVarint(ticket.generation);
+    putVarint(ticket.sequence);
+}
+
+void CallRecorder::put(const RecordTexts& rows)
+{
+    putVarint(rows.count);
+    for (size_t i = 0; i < rows.count; ++i) {
+        put(rows.texts[i]);
+    }
+}
+
+ChartSource record_chart_source(lv_obj_t* obj, ChartSource source)
+{
+    if (!gCallRecorder) return source;
+
+    uint32_t series = gCallRecorder->nextSeries(obj);
+    return [obj, series, source = std::move(source)](float* values, size_t max) {
+        size_t count = source(values, max);
+        if (gCallRecorder && count > 0 && gCallRecorder->knows(obj)) {
+            gCallRecorder->chartSamples(obj, series, values, count);
+        }
+        return count;
+    };
+}
+
+std::function<const char*(size_t)> record_log_source(lv_obj_t* obj, std::function<const char*(size_t)> line)
+{
+    if (!gCallRecorder) return line;
+
+    return [obj, line = std::move(line)](size_t index) {
+        const char* text = line(index);
+        if (gCallRecorder && gCallRecorder->knows(obj)) {
+            gCallRecorder->logViewLine(obj, text);
+        }
+        return text;
+    };
+}
+
+// ==================== Recording ====================
+
+int _lvStartRecording(const char* path)
+{
+    if (gCallRecorder || !path) {
+        return -1;
+    }
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return -1;
+    }
+    gCallRecorder = std::make_unique<CallRecorder>(file);
+    return 0;
+}
+
+void _lvStopRecording()
+{
+    if (!gCallRecorder) return;
+
+    gFinishedRecording = gCallRecorder->finish();
+    gCallRecorder.reset();
+}
+
+RecordingStats _lvGetRecordingStats()
+{
+    return gCallRecorder ? gCallRecorder->stats() : gFinishedRecording;
+}
+
+} // namespace adaptor
+} // namespace gui
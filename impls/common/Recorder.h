@@ -0,0 +1,263 @@
+#pragma once
+
+#include "../../iface/gui/Adaptor.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Call log ====================
+// Layout of a recording, independent of LVGL:
+//   header  "GUIR", u8 version
+//   record  varint microseconds since the previous record, u8 RecordOp, the arguments of the op
+// Integers are LEB128 varints (signed ones zigzag encoded), strings a varint of length + 1 (0 for nullptr)
+// followed by the bytes, colors and floats 4 bytes little endian. An object is the varint id the recorder
+// assigned when it was created, 0 for any object not created through the adaptor (e.g. the screen).
+//
+// Calls are logged before they run, except creations and _lvBeginImageLoad which log their result. Data
+// records (ChartSamples, LogViewLine) are what a source returned and follow the call that pulled them.
+// An object leaves the id table when LVGL deletes it, also as the child of a deleted object, so an address
+// LVGL hands out again is never logged under the id of the deleted object.
+
+static constexpr char kRecordMagic[4] = {'G', 'U', 'I', 'R'};
+static constexpr uint8_t kRecordVersion = 1;
+
+enum class RecordOp : uint8_t {
+    Loop,                       ///< One lv_timer_handler cycle of _lvLoop
+    Step,                       ///< u32 ms
+    BeginBuild,
+    EndBuild,
+    CreateObj,                  ///< new id, parent
+    DestroyObj,                 ///< obj
+    CreateStack,                ///< new id, parent, u8 axis, i32 spacing, i32 padding, u8 cross alignment
+    CreateZStack,               ///< new id, parent
+    SetFlexHorizontal,          ///< obj, u8 alignment
+    SetFlexVertical,            ///< obj, u8 alignment
+    CreateLabel,                ///< new id, parent
+    SetText,                    ///< obj, string
+    SetTextStatic,              ///< obj, string
+    CreateButton,               ///< new id, parent
+    SetButtonText,              ///< obj, string
+    SetButtonTextStatic,        ///< obj, string
+    SetOnClick,                 ///< obj
+    SetOnChildClick,            ///< obj
+    SetEventBubble,             ///< obj, bool
+    CreateList,                 ///< new id, parent
+    AddListItems,               ///< obj, varint count, count strings
+    RemoveListItem,             ///< obj, varint index
+    ClearListItems,             ///< obj
+    SetListOnItemSelected,      ///< obj
+    CreateLogView,              ///< new id, parent
+    SetLogViewSource,           ///< obj
+    UpdateLogView,              ///< obj, varint count, varint dropped
+    SetLogViewAutoScroll,       ///< obj, bool
+    LogViewLine,                ///< obj, string
+    SetTheme,                   ///< colors, i32 spacings, i32 radii, each count-prefixed
+    SetBgColorToken,            ///< obj, u8 token
+    SetTextColorToken,          ///< obj, u8 token
+    SetPaddingToken,            ///< obj, u8 token
+    SetRadiusToken,             ///< obj, u8 token
+    SetFontToken,               ///< obj, u8 token
+    CreateChart,                ///< new id, parent
+    AddChartSeries,             ///< obj, color
+    SetChartRange,              ///< obj, i32 min, i32 max
+    SetChartWindow,             ///< obj, u32 samples
+    ChartSamples,               ///< obj, u32 series, varint count, count floats
+    CreateImage,                ///< new id, parent
+    ShowCachedImage,            ///< obj, string path
+    BeginImageLoad,             ///< obj, u32 slot, u32 generation, u32 sequence
+    FinishImageLoad,            ///< u32 slot, u32 generation, u32 sequence, string path, bool decoded
+    SetImageCacheCapacity,      ///< varint bytes
+    MountAssetPack,             ///< string path
+    UnmountAssetPacks,
+    ShowPackedImage,            ///< obj, string name
+    SetBgColor,                 ///< obj, color
+    SetTextColor,               ///< obj, color
+    SetEnabled,                 ///< obj, bool
+    CreateSlider,               ///< new id, parent
+    SetSliderRange,             ///< obj, i32 min, i32 max
+    SetSliderValue,             ///< obj, i32 value, bool anim
+    SetSliderOnValueChanged,    ///< obj, policy
+    CreateBar,                  ///< new id, parent, i32 value
+    CreateProgressBar,          ///< new id, parent, i32 value
+    SetBarRange,                ///< obj, i32 min, i32 max
+    SetBarValue,                ///< obj, i32 value, bool anim
+    SetBarOnValueChanged,       ///< obj, policy
+    SetTextAreaOnTextChanged,   ///< obj, policy
+    CreateTextArea,             ///< new id, parent, string placeholder
+    SetTextAreaText,            ///< obj, string
+    SetTextAreaPlaceholder,     ///< obj, string
+    SetTextAreaOnEdit,          ///< obj, bool coalesce
+    AppendTextAreaText,         ///< obj, string, u32 cut position, u32 cut length
+    SetSize,                    ///< obj, i32 width, i32 height
+    SetWidth,                   ///< obj, i32 width
+    SetHeight,                  ///< obj, i32 height
+    SetTextColorNative,         ///< obj, color (opaque)
+    SetBgColorNative,           ///< obj, color (opaque)
+    SetTextAreaMaxLength,       ///< obj, u32 length
+    AddListItem,                ///< obj, string
+    CreateSpinner,              ///< new id, parent
+    SetSpinnerTime,             ///< obj, u32 ms
+    SetSpinnerAngle,            ///< obj, u32 degrees
+    CreateSwitch,               ///< new id, parent
+    SetSwitchState,             ///< obj, bool
+    SetSwitchOnToggle,          ///< obj
+    CreateCheckbox,             ///< new id, parent
+    SetCheckboxText,            ///< obj, string
+    SetCheckboxState,           ///< obj, bool
+    SetCheckboxOnToggle,        ///< obj
+    SetImageSrc,                ///< obj, bool source (the descriptor points into the application and is not logged)
+    Count
+};
+
+/**
+ * @brief The rows of _lvAddListItems as one argument
+ */
+struct RecordTexts
+{
+    const char* const* texts;
+    size_t count;
+};
+
+/**
+ * @brief Appends calls to a log file, owned by the adaptor while a recording runs
+ * @note Not thread-safe, like the adaptor calls it records it is used on the UI thread only
+ */
+class CallRecorder
+{
+public:
+    explicit CallRecorder(FILE* file);
+    ~CallRecorder();
+
+    CallRecorder(const CallRecorder&) = delete;
+    CallRecorder& operator=(const CallRecorder&) = delete;
+
+    template <typename... Args>
+    void call(RecordOp op, const Args&... args)
+    {
+        begin(op);
+        (put(args), ...);
+        end();
+    }
+
+    /**
+     * @brief Log the creation of obj, which gets the next id
+     */
+    template <typename... Args>
+    void created(RecordOp op, lv_obj_t* obj, const Args&... args)
+    {
+        begin(op);
+        putVarint(assignId(obj));
+        (put(args), ...);
+        end();
+    }
+
+    /**
+     * @brief Write the buffered records and close the file
+     */
+    RecordingStats finish();
+
+    void destroyed(lv_obj_t* obj);
+
+    /**
+     * @brief Drop a deleted object from the id table, called from its LV_EVENT_DELETE
+     */
+    void forget(const lv_obj_t* obj);
+    void chartSamples(lv_obj_t* obj, uint32_t series, const float* values, size_t count);
+    void logViewLine(lv_obj_t* obj, const char* text);
+
+    /**
+     * @brief Index the next series added to obj gets, counted the same way by the replayer
+     */
+    uint32_t nextSeries(lv_obj_t* obj) { return mSeries[obj]++; }
+    bool knows(lv_obj_t* obj) const { return mIds.count(obj) != 0; }
+
+    RecordingStats stats() const { return mStats; }
+
+private:
+    void begin(RecordOp op);
+    void end();
+    void write();
+    uint32_t assignId(lv_obj_t* obj);
+
+    void putVarint(uint64_t value);
+    void putFixed32(uint32_t value);
+
+    void put(lv_obj_t* obj);
+    void put(const char* text);
+    void put(bool value) { mBuffer.push_back(value ? 1 : 0); }
+    void put(int32_t value) { putVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 31)); }
+    void put(uint32_t value) { putVarint(value); }
+    void put(uint64_t value) { putVarint(value); }
+    void put(const style::Color& color) { putFixed32(color.value); }
+    void put(const style::StackLayout& layout);
+    void put(const style::Theme& theme);
+    void put(const EventPolicy& policy);
+    void put(const ImageTicket& ticket);
+    void put(const RecordTexts& rows);
+
+    template <typename E, std::enable_if_t<std::is_enum<E>::value, int> = 0>
+    void put(E value)
+    {
+        mBuffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    FILE* mFile;
+    std::vector<uint8_t> mBuffer;
+    std::chrono::steady_clock::time_point mLast;
+    std::unordered_map<const lv_obj_t*, uint32_t> mIds;
+    std::unordered_map<const lv_obj_t*, uint32_t> mSeries;
+    uint32_t mNextId = 1;
+    RecordingStats mStats;
+};
+
+extern std::unique_ptr<CallRecorder> gCallRecorder;
+
+/**
+ * @brief Log a call if a recording runs, a null check otherwise
+ */
+template <typename... Args>
+inline void record_call(RecordOp op, const Args&... args)
+{
+    if (gCallRecorder) {
+        gCallRecorder->call(op, args...);
+    }
+}
+
+template <typename... Args>
+inline lv_obj_t* record_created(RecordOp op, lv_obj_t* obj, const Args&... args)
+{
+    if (gCallRecorder && obj) {
+        gCallRecorder->created(op, obj, args...);
+    }
+    return obj;
+}
+
+inline void record_destroyed(lv_obj_t* obj)
+{
+    if (gCallRecorder) {
+        gCallRecorder->destroyed(obj);
+    }
+}
+
+/**
+ * @brief Wrap the source of a series so the samples it returns are logged, unchanged if no recording runs
+ */
+ChartSource record_chart_source(lv_obj_t* obj, ChartSource source);
+
+/**
+ * @brief Wrap the line source of a log view so the lines it returns are logged
+ */
+std::function<const char*(size_t)> record_log_source(lv_obj_t* obj, std::function<const char*(size_t)> line);
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,746 @@
+#include "AdaptorCommon.h"
+#include "Recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Replay ====================
+// A call is decoded into a closure and runs once the next call is reached, so the data records that follow
+// it (the samples and lines its sources returned in the session) are queued before the sources are pulled.
+
+class RecordReader
+{
+public:
+    explicit RecordReader(const std::vector<uint8_t>& data) : mData(data) {}
+
+    bool failed() const { return mFailed; }
+    void fail() { mFailed = true; }
+    bool atEnd() const { return mPos >= mData.size(); }
+    size_t remaining() const { return mData.size() - mPos; }
+
+    uint8_t byte()
+    {
+        if (mPos >= mData.size()) {
+            mFailed = true;
+            return 0;
+        }
+        return mData[mPos++];
+    }
+
+    bool flag() { return byte() != 0; }
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            value |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                return value;
+            }
+        }
+        mFailed = true;
+        return 0;
+    }
+
+    uint32_t u32()
+    {
+        uint64_t value = varint();
+        if (value > UINT32_MAX) {
+            mFailed = true;
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    int32_t i32()
+    {
+        uint32_t value = u32();
+        return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1u)));
+    }
+
+    uint32_t fixed32()
+    {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            value |= uint32_t(byte()) << shift;
+        }
+        return value;
+    }
+
+    /**
+     * @return false for a nullptr string
+     */
+    bool text(std::string& out)
+    {
+        uint64_t length = varint();
+        out.clear();
+        if (length == 0) {
+            return false;
+        }
+        if (length - 1 > remaining()) {
+            mFailed = true;
+            return false;
+        }
+        out.assign(reinterpret_cast<const char*>(mData.data() + mPos), length - 1);
+        mPos += length - 1;
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& mData;
+    size_t mPos = 0;
+    bool mFailed = false;
+};
+
+/**
+ * @brief Samples and lines of the session, pulled by the sources installed during the replay
+ * @note Shared with the sources, which may outlive the replay and find the queues empty then
+ */
+struct ReplayFeed
+{
+    std::map<std::pair<uint32_t, uint32_t>, std::deque<std::vector<float>>> samples;
+    std::map<uint32_t, std::deque<std::string>> lines;
+    std::map<uint32_t, std::string> current;    ///< Line returned last, valid until the next pull
+};
+
+struct TextArg
+{
+    std::string value;
+    bool present = false;
+
+    const char* c_str() const { return present ? value.c_str() : nullptr; }
+};
+
+using TicketKey = std::tuple<uint32_t, uint32_t, uint32_t>;
+
+class Replayer
+{
+public:
+    Replayer(const std::vector<uint8_t>& data, lv_obj_t* root)
+        : mIn(data), mRoot(root), mFeed(std::make_shared<ReplayFeed>())
+    {
+        mObjects.push_back(root);
+    }
+
+    int run(ReplaySpeed speed, ReplayStats& stats);
+
+private:
+    using Call = std::function<void()>;
+
+    lv_obj_t* object(uint32_t id) const { return id < mObjects.size() ? mObjects[id] : nullptr; }
+
+    /**
+     * @brief Read the id of a created object, the recorder hands them out densely in creation order
+     */
+    uint32_t createdId()
+    {
+        uint32_t id = mIn.u32();
+        if (id != mNextId) {
+            mIn.fail();
+        }
+        ++mNextId;
+        return id;
+    }
+
+    /**
+     * @param[in] obj Created object, nullptr if the parent was gone so the id still takes its place
+     */
+    void bind(uint32_t id, lv_obj_t* obj)
+    {
+        // createdId() let only the next id through and creations run in order
+        if (id == mObjects.size()) {
+            mObjects.push_back(obj);
+        }
+    }
+
+    TextArg text()
+    {
+        TextArg arg;
+        arg.present = mIn.text(arg.value);
+        return arg;
+    }
+
+    TicketKey ticketKey()
+    {
+        uint32_t slot = mIn.u32();
+        uint32_t generation = mIn.u32();
+        uint32_t sequence = mIn.u32();
+        return TicketKey{slot, generation, sequence};
+    }
+
+    EventPolicy policy()
+    {
+        EventPolicy policy;
+        policy.mode = static_cast<EventPolicy::Mode>(mIn.byte());
+        policy.intervalMs = mIn.u32();
+        policy.leading = mIn.flag();
+        policy.trailing = mIn.flag();
+        return policy;
+    }
+
+    void readData(RecordOp op);
+    Call decode(RecordOp op);
+
+    /**
+     * @brief A call on an existing object, skipped if the object is gone
+     */
+    template <typename F>
+    Call onObject(uint32_t id, F&& f)
+    {
+        return [this, id, f = std::forward<F>(f)]() {
+            if (lv_obj_t* obj = object(id)) {
+                f(obj);
+            }
+        };
+    }
+
+    /**
+     * @brief Decode a creation, create(parent) runs the adaptor call and the result gets the recorded id
+     */
+    template <typename F>
+    Call creation(F&& create)
+    {
+        uint32_t id = createdId();
+        uint32_t parent = mIn.u32();
+        return [this, id, parent, create = std::forward<F>(create)]() {
+            lv_obj_t* obj = object(parent);
+            bind(id, obj ? create(obj) : nullptr);
+        };
+    }
+
+    void step(uint32_t ms)
+    {
+        mStats.frames += _lvStep(ms);
+        ++mStats.steps;
+    }
+
+    RecordReader mIn;
+    lv_obj_t* mRoot;
+    std::vector<lv_obj_t*> mObjects;    ///< By recorded id, 0 is the root
+    std::shared_ptr<ReplayFeed> mFeed;
+    std::map<TicketKey, ImageTicket> mTickets;
+    std::map<uint32_t, uint32_t> mSeries;
+    uint32_t mNextId = 1;       ///< Id the next creation record has to carry
+    uint64_t mSteppedMs = 0;    ///< Recorded time the LVGL clock has been advanced to
+    uint64_t mCallUs = 0;       ///< Recorded time of the call being decoded
+    ReplayStats mStats;
+};
+
+void Replayer::readData(RecordOp op)
+{
+    uint32_t id = mIn.u32();
+    if (op == RecordOp::LogViewLine) {
+        TextArg line = text();
+        mFeed->lines[id].push_back(std::move(line.value));
+        return;
+    }
+
+    uint32_t series = mIn.u32();
+    uint64_t count = mIn.varint();
+    if (count > mIn.remaining() / sizeof(uint32_t)) {
+        mIn.fail();
+        return;
+    }
+    std::vector<float> values(count);
+    for (auto& value : values) {
+        uint32_t bits = mIn.fixed32();
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+    mFeed->samples[{id, series}].push_back(std::move(values));
+}
+
+static bool takes_object(RecordOp op)
+{
+    switch (op) {
+        case RecordOp::Loop:
+        case RecordOp::Step:
+        case RecordOp::BeginBuild:
+        case RecordOp::EndBuild:
+        case RecordOp::CreateObj:
+        case RecordOp::CreateStack:
+        case RecordOp::CreateZStack:
+        case RecordOp::CreateLabel:
+        case RecordOp::CreateButton:
+        case RecordOp::CreateList:
+        case RecordOp::CreateLogView:
+        case RecordOp::SetTheme:
+        case RecordOp::CreateChart:
+        case RecordOp::CreateImage:
+        case RecordOp::FinishImageLoad:
+        case RecordOp::SetImageCacheCapacity:
+        case RecordOp::MountAssetPack:
+        case RecordOp::UnmountAssetPacks:
+        case RecordOp::CreateSlider:
+        case RecordOp::CreateBar:
+        case RecordOp::CreateProgressBar:
+        case RecordOp::CreateTextArea:
+        case RecordOp::CreateSpinner:
+        case RecordOp::CreateSwitch:
+        case RecordOp::CreateCheckbox:
+            return false;
+        default:
+            return true;
+    }
+}
+
+Replayer::Call Replayer::decode(RecordOp op)
+{
+    using namespace style;
+
+    // Most calls take their object first, it is read before the arguments the closures capture
+    uint32_t id = takes_object(op) ? mIn.u32() : 0;
+
+    switch (op) {
+        case RecordOp::Loop: {
+            // Advance the clock by the recorded time since the previous cycle
+            uint64_t ms = mCallUs / 1000;
+            uint32_t delta = static_cast<uint32_t>(ms - std::min(ms, mSteppedMs));
+            mSteppedMs = std::max(ms, mSteppedMs);
+            return [this, delta]() { step(delta); };
+        }
+        case RecordOp::Step: {
+            uint32_t ms = mIn.u32();
+            mSteppedMs = mCallUs / 1000;
+            return [this, ms]() { step(ms); };
+        }
+        case RecordOp::BeginBuild:
+            return []() { _lvBeginBuild(); };
+        case RecordOp::EndBuild:
+            return []() { _lvEndBuild(); };
+        case RecordOp::CreateObj:
+            return creation([](lv_obj_t* parent) { return _lvCreateObj(parent); });
+        case RecordOp::DestroyObj:
+            return [this, id]() {
+                lv_obj_t* obj = object(id);
+                if (obj && obj != mRoot) {
+                    _lvDestroyObj(obj);
+                    mObjects[id] = nullptr;
+                }
+            };
+        case RecordOp::CreateStack: {
+            uint32_t created = createdId();
+            uint32_t parent = mIn.u32();
+            StackLayout layout;
+            layout.axis = static_cast<Layout::Axis>(mIn.byte());
+            layout.spacing = mIn.i32();
+            layout.padding = mIn.i32();
+            layout.crossAlign = static_cast<Layout::Alignment>(mIn.byte());
+            return [this, created, parent, layout]() {
+                lv_obj_t* obj = object(parent);
+                bind(created, obj ? _lvCreateStack(obj, layout) : nullptr);
+            };
+        }
+        case RecordOp::CreateZStack:
+            return creation([](lv_obj_t* parent) { return _lvCreateZStack(parent); });
+        case RecordOp::SetFlexHorizontal:
+            return onObject(id, [align = static_cast<Layout::Horizontal>(mIn.byte())](lv_obj_t* obj) {
+                _lvSetFlexAlignment(obj, align);
+            });
+        case RecordOp::SetFlexVertical:
+            return onObject(id, [align = static_cast<Layout::Vertical>(mIn.byte())](lv_obj_t* obj) {
+                _lvSetFlexAlignment(obj, align);
+            });
+        case RecordOp::CreateLabel:
+            return creation([](lv_obj_t* parent) { return _lvCreateLabel(parent); });
+        case RecordOp::SetText:
+        case RecordOp::SetTextStatic:
+            // Static texts are set as copies, the log does not outlive the replay
+            return onObject(id, [t = text()](lv_obj_t* obj) { _lvSetText(obj, t.c_str()); });
+        case RecordOp::CreateButton:
+            return creation([](lv_obj_t* parent) { return _lvCreateButton(parent); });
+        case RecordOp::SetButtonText:
+        case RecordOp::SetButtonTextStatic:
+            return onObject(id, [t = text()](lv_obj_t* obj) { _lvSetButtonText(obj, t.c_str()); });
+        case RecordOp::SetOnClick:
+            return onObject(id, [](lv_obj_t* obj) { _lvSetOnClick(obj, []() {}); });
+        case RecordOp::SetOnChildClick:
+            return onObject(id, [](lv_obj_t* obj) { _lvSetOnChildClick(obj, [](lv_obj_t*) {}); });
+        case RecordOp::SetEventBubble:
+            return onObject(id, [on = mIn.flag()](lv_obj_t* obj) { _lvSetEventBubble(obj, on); });
+        case RecordOp::CreateList:
+            return creation([](lv_obj_t* parent) { return _lvCreateList(parent); });
+        case RecordOp::AddListItems: {
+            uint64_t count = mIn.varint();
+            std::vector<TextArg> rows;
+            for (uint64_t i = 0; i < count && !mIn.failed(); ++i) {
+                rows.push_back(text());
+            }
+            return [this, id, rows = std::move(rows)]() {
+                lv_obj_t* obj = object(id);
+                if (!obj) return;
+                std::vector<const char*> texts;
+                for (const auto& row : rows) {
+                    texts.push_back(row.c_str());
+                }
+                _lvAddListItems(obj, texts.data(), texts.size());
+            };
+        }
+        case RecordOp::RemoveListItem:
+            return onObject(id, [index = size_t(mIn.varint())](lv_obj_t* obj) { _lvRemoveListItem(obj, index); });
+        case RecordOp::ClearListItems:
+            return onObject(id, [](lv_obj_t* obj) { _lvClearListItems(obj); });
+        case RecordOp::SetListOnItemSelected:
+            return onObject(id, [](lv_obj_t* obj) { _lvSetListOnItemSelected(obj, [](int, const std::string&) {}); });
+        case RecordOp::CreateLogView:
+            return creation([](lv_obj_t* parent) { return _lvCreateLogView(parent); });
+        case RecordOp::SetLogViewSource: {
+            return [this, id]() {
+                lv_obj_t* obj = object(id);
+                if (!obj) return;
+                _lvSetLogViewSource(obj, [feed = mFeed, id](size_t) -> const char* {
+                    auto& queue = feed->lines[id];
+                    std::string& line = feed->current[id];
+                    line.clear();
+                    if (!queue.empty()) {
+                        line = std::move(queue.front());
+                        queue.pop_front();
+                    }
+                    return line.c_str();
+                });
+            };
+        }
+        case RecordOp::UpdateLogView: {
+            uint64_t count = mIn.varint();
+            uint64_t dropped = mIn.varint();
+            return onObject(id, [count, dropped](lv_obj_t* obj) { _lvUpdateLogView(obj, count, dropped); });
+        }
+        case RecordOp::SetLogViewAutoScroll:
+            return onObject(id, [on = mIn.flag()](lv_obj_t* obj) { _lvSetLogViewAutoScroll(obj, on); });
+        case RecordOp::SetTheme: {
+            // Fonts are not in the log, the theme keeps the ones in effect
+            Theme theme = _lvGetTheme();
+            uint64_t colors = mIn.varint();
+            for (uint64_t i = 0; i < colors && !mIn.failed(); ++i) {
+                Color color{mIn.fixed32()};
+                if (i < theme.colors.size()) {
+                    theme.colors[i] = color;
+                }
+            }
+            uint64_t spacings = mIn.varint();
+            for (uint64_t i = 0; i < spacings && !mIn.failed(); ++i) {
+                int32_t space = mIn.i32();
+                if (i < theme.spacing.size()) {
+                    theme.spacing[i] = static_cast<int16_t>(space);
+                }
+            }
+            uint64_t radii = mIn.varint();
+            for (uint64_t i = 0; i < radii && !mIn.failed(); ++i) {
+                int32_t radius = mIn.i32();
+                if (i < theme.radius.size()) {
+                    theme.radius[i] = static_cast<int16_t>(radius);
+                }
+            }
+            return [theme]() { _lvSetTheme(theme); };
+        }
+        case RecordOp::SetBgColorToken:
+            return onObject(id, [t = static_cast<ColorToken>(mIn.byte())](lv_obj_t* obj) {
+                _lvSetBgColorToken(obj, t);
+            });
+        case RecordOp::SetTextColorToken:
+            return onObject(id, [t = static_cast<ColorToken>(mIn.byte())](lv_obj_t* obj) {
+                _lvSetTextColorToken(obj, t);
+            });
+        case RecordOp::SetPaddingToken:
+            return onObject(id, [t = static_cast<SpacingToken>(mIn.byte())](lv_obj_t* obj) {
+                _lvSetPaddingToken(obj, t);
+            });
+        case RecordOp::SetRadiusToken:
+            return onObject(id, [t = static_cast<RadiusToken>(mIn.byte())](lv_obj_t* obj) {
+                _lvSetRadiusToken(obj, t);
+            });
+        case RecordOp::SetFontToken:
+            return onObject(id, [t = static_cast<FontToken>(mIn.byte())](lv_obj_t* obj) { _lvSetFontToken(obj, t); });
+        case RecordOp::CreateChart:
+            return creation([](lv_obj_t* parent) { return _lvCreateChart(parent); });
+        case RecordOp::AddChartSeries: {
+            Color color{mIn.fixed32()};
+            return [this, id, color]() {
+                lv_obj_t* obj = object(id);
+                if (!obj) return;
+                uint32_t series = mSeries[id]++;
+                _lvAddChartSeries(obj, color, [feed = mFeed, id, series](float* values, size_t max) -> size_t {
+                    auto& queue = feed->samples[{id, series}];
+                    if (queue.empty()) {
+                        return 0;
+                    }
+                    std::vector<float>& batch = queue.front();
+                    size_t count = std::min(max, batch.size());
+                    std::copy(batch.begin(), batch.begin() + count, values);
+                    batch.erase(batch.begin(), batch.begin() + count);
+                    if (batch.empty()) {
+                        queue.pop_front();
+                    }
+                    return count;
+                });
+            };
+        }
+        case RecordOp::SetChartRange: {
+            int32_t min = mIn.i32();
+            int32_t max = mIn.i32();
+            return onObject(id, [min, max](lv_obj_t* obj) { _lvSetChartRange(obj, min, max); });
+        }
+        case RecordOp::SetChartWindow:
+            return onObject(id, [samples = mIn.u32()](lv_obj_t* obj) { _lvSetChartWindow(obj, samples); });
+        case RecordOp::CreateImage:
+            return creation([](lv_obj_t* parent) { return _lvCreateImage(parent); });
+        case RecordOp::ShowCachedImage:
+            return onObject(id, [path = text()](lv_obj_t* obj) { _lvShowCachedImage(obj, path.c_str()); });
+        case RecordOp::BeginImageLoad: {
+            TicketKey key = ticketKey();
+            return [this, id, key]() {
+                if (lv_obj_t* obj = object(id)) {
+                    mTickets[key] = _lvBeginImageLoad(obj);
+                }
+            };
+        }
+        case RecordOp::FinishImageLoad: {
+            TicketKey key = ticketKey();
+            TextArg path = text();
+            bool decoded = mIn.flag();
+            return [this, key, path = std::move(path), decoded]() {
+                auto it = mTickets.find(key);
+                if (it == mTickets.end()) return;
+                // Decoded on the UI thread, the session did it on a worker
+                ImageRef image = decoded ? _lvDecodeImage(path.c_str()) : nullptr;
+                _lvFinishImageLoad(it->second, path.c_str(), std::move(image));
+                mTickets.erase(it);
+            };
+        }
+        case RecordOp::SetImageCacheCapacity:
+            return [bytes = size_t(mIn.varint())]() { _lvSetImageCacheCapacity(bytes); };
+        case RecordOp::MountAssetPack:
+            return [path = text()]() { _lvMountAssetPack(path.c_str()); };
+        case RecordOp::UnmountAssetPacks:
+            return []() { _lvUnmountAssetPacks(); };
+        case RecordOp::ShowPackedImage:
+            return onObject(id, [name = text()](lv_obj_t* obj) { _lvShowPackedImage(obj, name.c_str()); });
+        case RecordOp::SetBgColor:
+            return onObject(id, [color = Color{mIn.fixed32()}](lv_obj_t* obj) { _lvSetBgColor(obj, color); });
+        case RecordOp::SetTextColor:
+            return onObject(id, [color = Color{mIn.fixed32()}](lv_obj_t* obj) { _lvSetTextColor(obj, color); });
+        case RecordOp::SetEnabled:
+            return onObject(id, [on = mIn.flag()](lv_obj_t* obj) { _lvSetEnabled(obj, on); });
+        case RecordOp::CreateSlider:
+            return creation([](lv_obj_t* parent) { return _lvCreateSlider(parent); });
+        case RecordOp::SetSliderRange: {
+            int32_t min = mIn.i32();
+            int32_t max = mIn.i32();
+            return onObject(id, [min, max](lv_obj_t* obj) { _lvSetSliderRange(obj, min, max); });
+        }
+        case RecordOp::SetSliderValue: {
+            int32_t value = mIn.i32();
+            bool anim = mIn.flag();
+            return onObject(id, [value, anim](lv_obj_t* obj) { _lvSetSliderValue(obj, value, anim); });
+        }
+        case RecordOp::SetSliderOnValueChanged:
+            return onObject(id, [p = policy()](lv_obj_t* obj) { _lvSetSliderOnValueChanged(obj, [](int) {}, p); });
+        case RecordOp::CreateBar:
+        case RecordOp::CreateProgressBar: {
+            uint32_t created = createdId();
+            uint32_t parent = mIn.u32();
+            int32_t value = mIn.i32();
+            bool progress = op == RecordOp::CreateProgressBar;
+            return [this, created, parent, value, progress]() {
+                lv_obj_t* bar = nullptr;
+                if (lv_obj_t* obj = object(parent)) {
+                    bar = progress ? _lvCreateProgressBar(obj, value) : _lvCreateBar(obj, value);
+                }
+                bind(created, bar);
+            };
+        }
+        case RecordOp::SetBarRange: {
+            int32_t min = mIn.i32();
+            int32_t max = mIn.i32();
+            return onObject(id, [min, max](lv_obj_t* obj) { _lvSetBarRange(obj, min, max); });
+        }
+        case RecordOp::SetBarValue: {
+            int32_t value = mIn.i32();
+            bool anim = mIn.flag();
+            return onObject(id, [value, anim](lv_obj_t* obj) { _lvSetBarValue(obj, value, anim); });
+        }
+        case RecordOp::SetBarOnValueChanged:
+            return onObject(id, [p = policy()](lv_obj_t* obj) { _lvSetBarOnValueChanged(obj, [](int) {}, p); });
+        case RecordOp::SetTextAreaOnTextChanged:
+            return onObject(id, [p = policy()](lv_obj_t* obj) {
+                _lvSetTextAreaOnTextChanged(obj, [](const std::string&) {}, p);
+            });
+        case RecordOp::CreateTextArea: {
+            uint32_t created = createdId();
+            uint32_t parent = mIn.u32();
+            TextArg placeholder = text();
+            return [this, created, parent, placeholder = std::move(placeholder)]() {
+                lv_obj_t* obj = object(parent);
+                bind(created, obj ? _lvCreateTextArea(obj, placeholder.c_str()) : nullptr);
+            };
+        }
+        case RecordOp::SetTextAreaText:
+            return onObject(id, [t = text()](lv_obj_t* obj) { _lvSetTextAreaText(obj, t.c_str()); });
+        case RecordOp::SetTextAreaPlaceholder:
+            return onObject(id, [t = text()](lv_obj_t* obj) { _lvSetTextAreaPlaceholder(obj, t.c_str()); });
+        case RecordOp::SetTextAreaOnEdit:
+            return onObject(id, [coalesce = mIn.flag()](lv_obj_t* obj) {
+                _lvSetTextAreaOnEdit(obj, [](const TextEdit&) {}, coalesce);
+            });
+        case RecordOp::AppendTextAreaText: {
+            TextArg appended = text();
+            uint32_t cutPosition = mIn.u32();
+            uint32_t cutLength = mIn.u32();
+            return onObject(id, [appended = std::move(appended), cutPosition, cutLength](lv_obj_t* obj) {
+                _lvAppendTextAreaText(obj, appended.c_str(), cutPosition, cutLength);
+            });
+        }
+        case RecordOp::SetSize: {
+            int32_t width = mIn.i32();
+            int32_t height = mIn.i32();
+            return onObject(id, [width, height](lv_obj_t* obj) { _lvSetSize(obj, Size{width, height}); });
+        }
+        case RecordOp::SetWidth:
+            return onObject(id, [width = mIn.i32()](lv_obj_t* obj) { _lvSetWidth(obj, width); });
+        case RecordOp::SetHeight:
+            return onObject(id, [height = mIn.i32()](lv_obj_t* obj) { _lvSetHeight(obj, height); });
+        case RecordOp::SetTextColorNative:
+            return onObject(id, [color = Color{mIn.fixed32()}](lv_obj_t* obj) {
+                _lvSetTextColor(obj, to_lv_color(color));
+            });
+        case RecordOp::SetBgColorNative:
+            return onObject(id, [color = Color{mIn.fixed32()}](lv_obj_t* obj) {
+                _lvSetBgColor(obj, to_lv_color(color));
+            });
+        case RecordOp::SetTextAreaMaxLength:
+            return onObject(id, [length = mIn.u32()](lv_obj_t* obj) { _lvSetTextAreaMaxLength(obj, length); });
+        case RecordOp::AddListItem:
+            return onObject(id, [t = text()](lv_obj_t* obj) { _lvAddListItem(obj, t.c_str()); });
+        case RecordOp::CreateSpinner:
+            return creation([](lv_obj_t* parent) { return _lvCreateSpinner(parent); });
+        case RecordOp::SetSpinnerTime:
+            return onObject(id, [ms = mIn.u32()](lv_obj_t* obj) { _lvSetSpinnerTime(obj, ms); });
+        case RecordOp::SetSpinnerAngle:
+            return onObject(id, [angle = static_cast<uint16_t>(mIn.u32())](lv_obj_t* obj) {
+                _lvSetSpinnerAngle(obj, angle);
+            });
+        case RecordOp::CreateSwitch:
+            return creation([](lv_obj_t* parent) { return _lvCreateSwitch(parent); });
+        case RecordOp::SetSwitchState:
+            return onObject(id, [on = mIn.flag()](lv_obj_t* obj) { _lvSetSwitchState(obj, on); });
+        case RecordOp::SetSwitchOnToggle:
+            return onObject(id, [](lv_obj_t* obj) { _lvSetSwitchOnToggle(obj, [](bool) {}); });
+        case RecordOp::CreateCheckbox:
+            return creation([](lv_obj_t* parent) { return _lvCreateCheckbox(parent); });
+        case RecordOp::SetCheckboxText:
+            return onObject(id, [t = text()](lv_obj_t* obj) { _lvSetCheckboxText(obj, t.c_str()); });
+        case RecordOp::SetCheckboxState:
+            return onObject(id, [on = mIn.flag()](lv_obj_t* obj) { _lvSetCheckboxState(obj, on); });
+        case RecordOp::SetCheckboxOnToggle:
+            return onObject(id, [](lv_obj_t* obj) { _lvSetCheckboxOnToggle(obj, [](bool) {}); });
+        case RecordOp::SetImageSrc: {
+            // The session's descriptor is not in the log, only clearing the image replays
+            bool hasSource = mIn.flag();
+            return onObject(id, [hasSource](lv_obj_t* obj) {
+                if (!hasSource) {
+                    _lvSetImageSrc(obj, nullptr);
+                }
+            });
+        }
+        // Data records are read by readData, no default so that an op without a decoder is a -Wswitch warning
+        case RecordOp::ChartSamples:
+        case RecordOp::LogViewLine:
+        case RecordOp::Count:
+            break;
+    }
+    return nullptr;
+}
+
+int Replayer::run(ReplaySpeed speed, ReplayStats& stats)
+{
+    auto start = std::chrono::steady_clock::now();
+    Call pending;
+    uint64_t pendingUs = 0;
+    int result = 0;
+
+    auto flush = [&]() {
+        if (!pending) return;
+        if (speed == ReplaySpeed::Original) {
+            std::this_thread::sleep_until(start + std::chrono::microseconds(pendingUs));
+        }
+        pending();
+        pending = nullptr;
+        ++mStats.calls;
+    };
+
+    while (!mIn.atEnd()) {
+        uint64_t at = mCallUs + mIn.varint();
+        auto op = static_cast<RecordOp>(mIn.byte());
+        if (mIn.failed() || op >= RecordOp::Count) {
+            result = -1;
+            break;
+        }
+        mCallUs = at;
+
+        if (op == RecordOp::ChartSamples || op == RecordOp::LogViewLine) {
+            readData(op);
+        } else {
+            flush();
+            pending = decode(op);
+            pendingUs = at;
+        }
+        if (mIn.failed()) {
+            // Cut off in the middle of a record, the call is incomplete
+            pending = nullptr;
+            result = -1;
+            break;
+        }
+    }
+    flush();
+
+    mStats.recordedUs = mCallUs;
+    mStats.replayUs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    stats = mStats;
+    return result;
+}
+
+static bool read_recording(const char* path, std::vector<uint8_t>& data)
+{
+    FILE* file = path ? fopen(path, "rb") : nullptr;
+    if (!file) {
+        return false;
+    }
+    uint8_t chunk[16 * 1024];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    fclose(file);
+    return true;
+}
+
+int _lvReplay(const char* path, lv_obj_t* root, ReplaySpeed speed, ReplayStats* stats)
+{
+    std::vector<uint8_t> data;
+    size_t headerSize = sizeof(kRecordMagic) + 1;
+    if (!read_recording(path, data) || data.size() < headerSize ||
+        std::memcmp(data.data(), kRecordMagic, sizeof(kRecordMagic)) != 0 || data[4] != kRecordVersion) {
+        return -1;
+    }
+    data.erase(data.begin(), data.begin() + headerSize);
+
+    Replayer replayer(data, root);
+    ReplayStats result;
+    int ret = replayer.run(speed, result);
+    if (stats) {
+        *stats = result;
+    }
+    return ret;
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,225 @@
+#include "AdaptorCommon.h"
+#include "EventDispatcher.h"
+#include "Recorder.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Text area edits ====================
+// LVGL announces every edit with LV_EVENT_INSERT (the text to insert, or a single LV_KEY_DEL/LV_KEY_BACKSPACE
+// for a deletion before the cursor) and confirms it with LV_EVENT_VALUE_CHANGED. The edit is derived from the
+// announcement and the cursor. A change without an announcement (lv_textarea_set_text), a cursor that moved
+// unexpectedly or a length that does not match the derived edit (characters dropped by the accepted
+// characters or the max length) is reported as a replacement of the whole text.
+
+static uint32_t utf8_length(std::string_view text)
+{
+    uint32_t length = 0;
+    for (char c : text) {
+        length += (static_cast<uint8_t>(c) & 0xC0) != 0x80;
+    }
+    return length;
+}
+
+static void utf8_pop_back(std::string& text)
+{
+    while (!text.empty() && (static_cast<uint8_t>(text.back()) & 0xC0) == 0x80) {
+        text.pop_back();
+    }
+    if (!text.empty()) {
+        text.pop_back();
+    }
+}
+
+// Sent with LV_EVENT_VALUE_CHANGED by _lvAppendTextAreaText for the characters it cut
+struct TextCut
+{
+    uint32_t position;
+    uint32_t length;
+};
+
+class TextEditTracker
+{
+public:
+    TextEditTracker(lv_obj_t* obj, std::function<void(const TextEdit&)> callback, bool coalesce)
+        : mObj(obj), mCallback(std::move(callback)), mCoalesce(coalesce),
+          mLength(utf8_length(lv_textarea_get_text(obj)))
+    {
+    }
+
+    ~TextEditTracker()
+    {
+        if (mTimer) {
+            timer_delete(mTimer);
+        }
+    }
+
+    void onInsert(lv_event_t* e)
+    {
+        const auto* text = static_cast<const char*>(lv_event_get_param(e));
+        mAnnounced = text != nullptr;
+        mAnnouncedText.assign(text ? text : "");
+        mAnnouncedCursor = lv_textarea_get_cursor_pos(mObj);
+    }
+
+    void onValueChanged(lv_event_t* e)
+    {
+        bool announced = mAnnounced;
+        mAnnounced = false;
+
+        // The text as LVGL kept it, whatever the filters dropped from the announced edit
+        const char* text = lv_textarea_get_text(mObj);
+        uint32_t length = utf8_length(text);
+
+        const auto* cut = static_cast<const TextCut*>(lv_event_get_param(e));
+        if (cut && mLength >= cut->length && length == mLength - cut->length) {
+            _report(cut->position, cut->length, std::string_view());
+            return;
+        }
+
+        uint32_t cursor = lv_textarea_get_cursor_pos(mObj);
+        bool isDeletion = mAnnouncedText.size() == 1 &&
+                          (mAnnouncedText[0] == LV_KEY_DEL || mAnnouncedText[0] == LV_KEY_BACKSPACE);
+        if (!cut && announced && isDeletion && mAnnouncedCursor > 0 && cursor == mAnnouncedCursor - 1 &&
+            length + 1 == mLength) {
+            _report(cursor, 1, std::string_view());
+            return;
+        }
+        uint32_t insertedLength = utf8_length(mAnnouncedText);
+        if (!cut && announced && !isDeletion && cursor == mAnnouncedCursor + insertedLength &&
+            length == mLength + insertedLength) {
+            _report(mAnnouncedCursor, 0, mAnnouncedText);
+            return;
+        }
+        _report(0, mLength, text);
+    }
+
+private:
+    struct PendingEdit
+    {
+        uint32_t position;
+        uint32_t removed;
+        std::string inserted;
+    };
+
+    void _report(uint32_t position, uint32_t removed, std::string_view inserted)
+    {
+        uint32_t lengthBefore = mLength;
+        mLength = mLength - removed + utf8_length(inserted);
+        if (!mCoalesce) {
+            if (mCallback) mCallback(TextEdit{position, removed, inserted});
+            return;
+        }
+
+        if (mPending.empty()) {
+            mFrameStartLength = lengthBefore;
+        }
+        if (position == 0 && removed == lengthBefore) {
+            // Everything before is replaced, relative to the start of the frame
+            mPending.clear();
+            mPending.push_back(PendingEdit{0, mFrameStartLength, std::string(inserted)});
+        } else if (!_merge(position, removed, inserted)) {
+            mPending.push_back(PendingEdit{position, removed, std::string(inserted)});
+        }
+        _arm();
+    }
+
+    bool _merge(uint32_t position, uint32_t removed, std::string_view inserted)
+    {
+        if (mPending.empty()) {
+            return false;
+        }
+        PendingEdit& last = mPending.back();
+        uint32_t end = last.position + utf8_length(last.inserted);
+        if (removed == 0 && position == end) {
+            // Typing on
+            last.inserted.append(inserted.data(), inserted.size());
+            return true;
+        }
+        if (removed == 1 && inserted.empty() && !last.inserted.empty() && position + 1 == end) {
+            // Backspace over text typed in the same frame
+            utf8_pop_back(last.inserted);
+            if (last.inserted.empty() && last.removed == 0) {
+                mPending.pop_back();
+            }
+            return true;
+        }
+        if (inserted.empty() && last.inserted.empty() && position + removed == last.position) {
+            // Backspacing on
+            last.position = position;
+            last.removed += removed;
+            return true;
+        }
+        return false;
+    }
+
+    void _arm()
+    {
+        if (!mTimer) {
+            mTimer = lv_timer_create(_onTimer, 0, this);
+        }
+        lv_timer_reset(mTimer);
+        lv_timer_resume(mTimer);
+    }
+
+    static void _onTimer(lv_timer_t* timer)
+    {
+        auto* self = static_cast<TextEditTracker*>(timer_user_data(timer));
+        lv_timer_pause(timer);
+        // The callback may edit the text again, those edits go to the next frame
+        std::vector<PendingEdit> pending;
+        pending.swap(self->mPending);
+        for (const PendingEdit& edit : pending) {
+            if (self->mCallback) self->mCallback(TextEdit{edit.position, edit.removed, edit.inserted});
+        }
+    }
+
+    lv_obj_t* mObj;
+    std::function<void(const TextEdit&)> mCallback;
+    bool mCoalesce;
+    uint32_t mLength;
+
+    bool mAnnounced = false;
+    std::string mAnnouncedText;
+    uint32_t mAnnouncedCursor = 0;
+
+    std::vector<PendingEdit> mPending;
+    uint32_t mFrameStartLength = 0;
+    lv_timer_t* mTimer = nullptr;
+};
+
+void _lvSetTextAreaOnEdit(lv_obj_t* obj, std::function<void(const TextEdit&)> callback, bool coalesce)
+{
+    record_call(RecordOp::SetTextAreaOnEdit, obj, coalesce);
+    // Owned by the two handlers, released with them when the object is deleted
+    auto tracker = std::make_shared<TextEditTracker>(obj, std::move(callback), coalesce);
+    auto& dispatcher = EventDispatcher::instance();
+    dispatcher.add(obj, LV_EVENT_INSERT, EventArg::Event,
+                   std::function<void(lv_event_t*)>([tracker](lv_event_t* e) { tracker->onInsert(e); }));
+    dispatcher.add(obj, LV_EVENT_VALUE_CHANGED, EventArg::Event,
+                   std::function<void(lv_event_t*)>([tracker](lv_event_t* e) { tracker->onValueChanged(e); }));
+}
+
+void _lvAppendTextAreaText(lv_obj_t* obj, const char* text, uint32_t cutPosition, uint32_t cutLength)
+{
+    record_call(RecordOp::AppendTextAreaText, obj, text, cutPosition, cutLength);
+    if (cutLength > 0) {
+        // Cut on the label directly, deleting through the text area would move the rest once per character
+        lv_label_cut_text(lv_textarea_get_label(obj), cutPosition, cutLength);
+        TextCut cut{cutPosition, cutLength};
+        send_event(obj, LV_EVENT_VALUE_CHANGED, &cut);
+    }
+    lv_textarea_set_cursor_pos(obj, LV_TEXTAREA_CURSOR_LAST);
+    if (text && *text) {
+        lv_textarea_add_text(obj, text);
+    }
+}
+
+} // namespace adaptor
+} // namespace gui
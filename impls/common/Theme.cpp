@@ -0,0 +1,222 @@
+#include "AdaptorCommon.h"
+#include "Recorder.h"
+
+#include <array>
+#include <vector>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Theme ====================
+// The token styles are created with the dark theme on first use and never move, objects keep pointers to them.
+// A switch rewrites the styles whose value changed first and then reports them with one walk of LVGL over the
+// screens: the style itself if only one that an object has used changed, all styles (NULL) otherwise.
+
+enum class TokenKind : uint8_t {
+    BgColor,
+    TextColor,
+    Padding,
+    Radius,
+    Font,
+    Count
+};
+
+class ThemeStyles
+{
+public:
+    static ThemeStyles& instance()
+    {
+        static ThemeStyles sInstance;
+        return sInstance;
+    }
+
+    const style::Theme& theme() const { return mTheme; }
+
+    void set(lv_obj_t* obj, TokenKind kind, size_t token)
+    {
+        // One token per kind, an older one would shadow or be shadowed depending on the order
+        for (Slot& slot : mSlots[size_t(kind)]) {
+            lv_obj_remove_style(obj, &slot.style, LV_PART_MAIN);
+        }
+        Slot& slot = mSlots[size_t(kind)][token];
+        slot.used = true;
+        lv_obj_add_style(obj, &slot.style, LV_PART_MAIN);
+    }
+
+    void apply(const style::Theme& theme)
+    {
+        lv_style_t* changed = nullptr;
+        size_t changedCount = 0;
+        for (size_t kind = 0; kind < size_t(TokenKind::Count); ++kind) {
+            for (size_t token = 0; token < mSlots[kind].size(); ++token) {
+                if (!_differs(TokenKind(kind), token, theme)) {
+                    continue;
+                }
+                Slot& slot = mSlots[kind][token];
+                _write(slot.style, TokenKind(kind), token, theme);
+                if (slot.used) {
+                    changed = &slot.style;
+                    ++changedCount;
+                }
+            }
+        }
+        mTheme = theme;
+        if (changedCount > 0) {
+            lv_obj_report_style_change(changedCount == 1 ? changed : nullptr);
+        }
+    }
+
+private:
+    struct Slot
+    {
+        lv_style_t style;
+        bool used = false;
+    };
+
+    ThemeStyles() : mTheme(style::Theme::dark())
+    {
+        const size_t counts[] = {size_t(style::ColorToken::Count), size_t(style::ColorToken::Count),
+                                 size_t(style::SpacingToken::Count), size_t(style::RadiusToken::Count),
+                                 size_t(style::FontToken::Count)};
+        for (size_t kind = 0; kind < size_t(TokenKind::Count); ++kind) {
+            // Sized once, the slots must keep their address
+            mSlots[kind] = std::vector<Slot>(counts[kind]);
+            for (size_t token = 0; token < counts[kind]; ++token) {
+                lv_style_init(&mSlots[kind][token].style);
+                _write(mSlots[kind][token].style, TokenKind(kind), token, mTheme);
+            }
+        }
+    }
+
+    bool _differs(TokenKind kind, size_t token, const style::Theme& theme) const
+    {
+        switch (kind) {
+            case TokenKind::BgColor:
+            case TokenKind::TextColor:
+                return theme.colors[token] != mTheme.colors[token];
+            case TokenKind::Padding:
+                return theme.spacing[token] != mTheme.spacing[token];
+            case TokenKind::Radius:
+                return theme.radius[token] != mTheme.radius[token];
+            case TokenKind::Font:
+                return theme.fonts[token] != mTheme.fonts[token];
+            default:
+                return false;
+        }
+    }
+
+    static void _write(lv_style_t& style, TokenKind kind, size_t token, const style::Theme& theme)
+    {
+        switch (kind) {
+            case TokenKind::BgColor:
+                lv_style_set_bg_color(&style, to_lv_color(theme.colors[token]));
+                lv_style_set_bg_opa(&style, to_lv_opa(theme.colors[token]));
+                break;
+            case TokenKind::TextColor:
+                lv_style_set_text_color(&style, to_lv_color(theme.colors[token]));
+                lv_style_set_text_opa(&style, to_lv_opa(theme.colors[token]));
+                break;
+            case TokenKind::Padding:
+                lv_style_set_pad_all(&style, theme.spacing[token]);
+                break;
+            case TokenKind::Radius:
+                lv_style_set_radius(&style, theme.radius[token]);
+                break;
+            case TokenKind::Font:
+                if (theme.fonts[token]) {
+                    lv_style_set_text_font(&style, theme.fonts[token]);
+                } else {
+                    lv_style_remove_prop(&style, LV_STYLE_TEXT_FONT);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    style::Theme mTheme;
+    std::array<std::vector<Slot>, size_t(TokenKind::Count)> mSlots;
+};
+
+void _lvSetTheme(const style::Theme& theme)
+{
+    record_call(RecordOp::SetTheme, theme);
+    ThemeStyles::instance().apply(theme);
+}
+
+const style::Theme& _lvGetTheme()
+{
+    return ThemeStyles::instance().theme();
+}
+
+void _lvSetBgColorToken(lv_obj_t* obj, style::ColorToken token)
+{
+    record_call(RecordOp::SetBgColorToken, obj, token);
+    ThemeStyles::instance().set(obj, TokenKind::BgColor, size_t(token));
+}
+
+void _lvSetTextColorToken(lv_obj_t* obj, style::ColorToken token)
+{
+    record_call(RecordOp::SetTextColorToken, obj, token);
+    ThemeStyles::instance().set(obj, TokenKind::TextColor, size_t(token));
+}
+
+void _lvSetPaddingToken(lv_obj_t* obj, style::SpacingToken token)
+{
+    record_call(RecordOp::SetPaddingToken, obj, token);
+    ThemeStyles::instance().set(obj, TokenKind::Padding, size_t(token));
+}
+
+void _lvSetRadiusToken(lv_obj_t* obj, style::RadiusToken token)
+{
+    record_call(RecordOp::SetRadiusToken, obj, token);
+    ThemeStyles::instance().set(obj, TokenKind::Radius, size_t(token));
+}
+
+void _lvSetFontToken(lv_obj_t* obj, style::FontToken token)
+{
+    record_call(RecordOp::SetFontToken, obj, token);
+    ThemeStyles::instance().set(obj, TokenKind::Font, size_t(token));
+}
+
+ThemeSwitchBenchmark _lvBenchmarkThemeSwitch(uint32_t objects)
+{
+    ThemeSwitchBenchmark result;
+    result.objects = objects;
+    ThemeStyles& styles = ThemeStyles::instance();
+    const style::Theme original = styles.theme();
+    style::Theme inverted = original;
+    for (style::Color& color : inverted.colors) {
+        color.value ^= 0x00FFFFFF;
+    }
+
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    std::vector<lv_obj_t*> created;
+    created.reserve(objects);
+    for (uint32_t i = 0; i < objects; ++i) {
+        lv_obj_t* obj = lv_obj_create(screen);
+        styles.set(obj, TokenKind::BgColor, size_t(style::ColorToken::BgTop));
+        styles.set(obj, TokenKind::TextColor, size_t(style::ColorToken::TextPrimary));
+        created.push_back(obj);
+    }
+
+    uint64_t start = steady_us();
+    styles.apply(inverted);
+    result.sharedUs = steady_us() - start;
+
+    lv_color_t bg = to_lv_color(original.color(style::ColorToken::BgTop));
+    lv_color_t text = to_lv_color(original.color(style::ColorToken::TextPrimary));
+    start = steady_us();
+    for (lv_obj_t* obj : created) {
+        lv_obj_set_style_bg_color(obj, bg, LV_PART_MAIN);
+        lv_obj_set_style_text_color(obj, text, LV_PART_MAIN);
+    }
+    result.localUs = steady_us() - start;
+
+    obj_delete(screen);
+    styles.apply(original);
+    return result;
+}
+
+} // namespace adaptor
+} // namespace gui
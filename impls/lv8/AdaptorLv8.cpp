@@ -1,532 +1,182 @@
-#include "../../iface/gui/Adaptor.h"
-#include "../../iface/gui/style/Color.h"
+#include "../common/AdaptorCommon.h"
 
 #include <lvgl.h>
-#include <unistd.h>
 
-namespace gui {
-namespace adaptor {
-
-int _lvPreinit()
-{ 
-    // do nothing
-    return 0;
-}
+#if LV_USE_PNG && LV_MEM_CUSTOM
+#include <src/extra/libs/png/lodepng.h>
+#endif
 
-int _lvInit()
-{
-    lv_init();
-    return 0;
-}
+#include <cstring>
+#include <memory>
+#include <vector>
 
-void _lvDeinit()
-{
-    return;
-}
+#if LVGL_VERSION_MAJOR != 8
+#error "AdaptorLv8.cpp is the LVGL 8 backend, configure with GUI_LVGL_VERSION=9 for LVGL 9"
+#endif
 
-void _lvLoop()
-{
-    while (true) {
-        lv_timer_handler();
-        usleep(5000);
-    }
-    return;
-}
+// The adaptor itself is in impls/common, this file holds what LVGL 8 does differently from LVGL 9 beyond the
+// calls LvCompat.h maps: the display driver hooks of the redraw profiler, the image formats and the asset pack
+// header.
 
-void _lvAsyncCall(std::function<void()> task)
-{
-    auto *taskPtr = new std::function<void()>(std::move(task));
+namespace gui {
+namespace adaptor {
 
-    lv_async_call([](void* user_data) {
-        auto* actualTask = static_cast<std::function<void()>*>(user_data);
-        try {
-            (*actualTask)();
-        } catch (...) {
-            // TODO: LOG ERROR
-        }
-        delete actualTask;
-    }, taskPtr);
-}
+// ==================== Redraw profiler ====================
+// LVGL calls the driver's rounder for every invalidated area, so wrapping it tells which areas are
+// invalidated while a view is tagged. The refresh timer is wrapped as well: it ends a frame, and the
+// rounder calls made while rendering only split the frame into parts and are no invalidations.
 
-lv_obj_t* _lvCreateObj(lv_obj_t* parent)
+struct RedrawHooks
 {
-    return lv_obj_create(parent);
-}
+    bool enabled = false;
+    bool rendering = false;
+    lv_disp_t* disp = nullptr;
+    void (*rounder)(lv_disp_drv_t*, lv_area_t*) = nullptr;
+    void (*flush)(lv_disp_drv_t*, const lv_area_t*, lv_color_t*) = nullptr;
+    lv_timer_cb_t refresh = nullptr;
+};
 
-void _lvDestroyObj(lv_obj_t* obj)
-{
-    lv_obj_del(obj);
-}
+static RedrawHooks gRedrawHooks;
 
-// Generic helper to create a container with flex layout
-static lv_obj_t* create_flex_container(lv_obj_t* parent, lv_flex_flow_t flow)
+static void redraw_rounder_cb(lv_disp_drv_t* drv, lv_area_t* area)
 {
-    lv_obj_t* cont = lv_obj_create(parent);
-    lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_obj_set_layout(cont, LV_LAYOUT_FLEX);
-    lv_obj_set_flex_flow(cont, flow);
-    return cont;
-}
-
-void _lvSetStyleGap(lv_obj_t* obj, int gap, lv_flex_flow_t flow)
-{
-    if (flow == LV_FLEX_FLOW_COLUMN) {
-        lv_obj_set_style_pad_row(obj, gap, LV_PART_MAIN);
-    } else { // LV_FLEX_FLOW_ROW or ROW_WRAP
-        lv_obj_set_style_pad_column(obj, gap, LV_PART_MAIN);
+    if (gRedrawHooks.rounder) {
+        gRedrawHooks.rounder(drv, area);
     }
-}
-
-void _lvSetFlexAlignment(lv_obj_t* obj, gui::style::Layout::Horizontal align)
-{
-    lv_flex_align_t lv_align;
-    switch (align) {
-        case gui::style::Layout::Horizontal::Leading: {
-            lv_align = LV_FLEX_ALIGN_START;
-        }
-        break;
-        case gui::style::Layout::Horizontal::Center: {
-            lv_align = LV_FLEX_ALIGN_CENTER;
-        }
-        break;
-        case gui::style::Layout::Horizontal::Trailing: {
-            lv_align = LV_FLEX_ALIGN_END;
-        }
-        break;
-    }
-    lv_obj_set_style_flex_cross_place(obj, lv_align, LV_PART_MAIN);
-}
-
-void _lvSetFlexAlignment(lv_obj_t* obj, gui::style::Layout::Vertical align)
-{
-    lv_flex_align_t lv_align;
-    switch (align) {
-        case gui::style::Layout::Vertical::Top: {
-            lv_align = LV_FLEX_ALIGN_START;
-        }
-        break;
-        case gui::style::Layout::Vertical::Center: {
-            lv_align = LV_FLEX_ALIGN_CENTER;
-        }
-        break;
-        case gui::style::Layout::Vertical::Bottom: {
-            lv_align = LV_FLEX_ALIGN_END;
-        }
-        break;
+    if (!gRedrawHooks.rendering) {
+        redraw_invalidated(area);
     }
-    lv_obj_set_style_flex_cross_place(obj, lv_align, LV_PART_MAIN);
-}
-
-lv_obj_t* _lvCreateVStack(lv_obj_t* parent)
-{
-    return create_flex_container(parent, LV_FLEX_FLOW_COLUMN);
-}
-
-lv_obj_t* _lvCreateHStack(lv_obj_t* parent)
-{
-    return create_flex_container(parent, LV_FLEX_FLOW_ROW);
 }
 
-lv_obj_t* _lvCreateZStack(lv_obj_t* parent)
+static void redraw_flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* colors)
 {
-    lv_obj_t* cont = lv_obj_create(parent);
-    lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    return cont;
+    redraw_flushed(area);
+    gRedrawHooks.flush(drv, area, colors);
 }
 
-lv_obj_t* _lvCreateLabel(lv_obj_t* parent)
+static void redraw_refresh_cb(lv_timer_t* timer)
 {
-    return lv_label_create(parent);
+    gRedrawHooks.rendering = true;
+    gRedrawHooks.refresh(timer);
+    gRedrawHooks.rendering = false;
+    redraw_refreshed();
 }
 
-void _lvSetText(lv_obj_t* obj, const char* text)
+void _lvEnableRedrawProfiler(bool isEnabled)
 {
-    lv_label_set_text(obj, text);
-}
+    if (isEnabled == gRedrawHooks.enabled) return;
 
-lv_obj_t* _lvCreateButton(lv_obj_t* parent)
-{
-    return lv_btn_create(parent);
-}
+    if (isEnabled) {
+        lv_disp_t* disp = lv_disp_get_default();
+        if (!disp || !disp->driver || !disp->driver->flush_cb || !disp->refr_timer) return;
 
-void _lvSetButtonText(lv_obj_t* obj, const char* text)
-{
-    if (!text) return;
-    
-    // Check if button already has a label
-    lv_obj_t* label = lv_obj_get_child(obj, 0);
-    if (label && lv_obj_check_type(label, &lv_label_class)) {
-        lv_label_set_text(label, text);
+        gRedrawHooks.disp = disp;
+        gRedrawHooks.rounder = disp->driver->rounder_cb;
+        gRedrawHooks.flush = disp->driver->flush_cb;
+        gRedrawHooks.refresh = disp->refr_timer->timer_cb;
+        disp->driver->rounder_cb = redraw_rounder_cb;
+        disp->driver->flush_cb = redraw_flush_cb;
+        disp->refr_timer->timer_cb = redraw_refresh_cb;
     } else {
-        // Create new label
-        label = lv_label_create(obj);
-        lv_label_set_text(label, text);
-        lv_obj_center(label);
+        gRedrawHooks.disp->driver->rounder_cb = gRedrawHooks.rounder;
+        gRedrawHooks.disp->driver->flush_cb = gRedrawHooks.flush;
+        gRedrawHooks.disp->refr_timer->timer_cb = gRedrawHooks.refresh;
+        gRedrawHooks.disp = nullptr;
     }
+    gRedrawHooks.enabled = isEnabled;
 }
 
-// Event handler for button clicks
-static void button_event_cb(lv_event_t* e)
-{
-    auto* callback = static_cast<std::function<void()>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        (*callback)();
-    }
-}
-
-void _lvSetOnClick(lv_obj_t* obj, std::function<void()> callback)
-{
-    // We need to store the callback on the heap so it persists.
-    // The raw pointer is stored as user data. We must deallocate it when the object is deleted.
-    auto* callback_ptr = new std::function<void()>(std::move(callback));
-    lv_obj_add_event_cb(obj, button_event_cb, LV_EVENT_CLICKED, callback_ptr);
-
-    // Add a cleanup event to delete the callback
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void()>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
+// ==================== Image decoding ====================
+// Supported files are LVGL 8's binary format (.bin, the header followed by the pixels) and PNG if LVGL is built
+// with LV_USE_PNG and a thread-safe allocator (LV_MEM_CUSTOM).
 
-void _lvSetSize(lv_obj_t* obj, const gui::style::Size& size)
+static std::shared_ptr<DecodedImage> make_image(uint32_t cf, uint32_t w, uint32_t h, std::vector<uint8_t>&& data)
 {
-    lv_obj_set_size(obj, size.width, size.height);
+    auto image = std::make_shared<DecodedImage>();
+    image->data = std::move(data);
+    image->dsc.header.always_zero = 0;
+    image->dsc.header.cf = cf;
+    image->dsc.header.w = w;
+    image->dsc.header.h = h;
+    image->dsc.data_size = static_cast<uint32_t>(image->data.size());
+    image->dsc.data = image->data.data();
+    return image;
 }
 
-void _lvSetTextColor(lv_obj_t* obj, lv_color_t color)
+std::shared_ptr<DecodedImage> decode_lvgl_bin(const std::vector<uint8_t>& file)
 {
-    lv_obj_set_style_text_color(obj, color, LV_PART_MAIN);
-}
-
-void _lvSetTextColor(lv_obj_t* obj, const gui::style::Color& color)
-{
-    lv_color_t lv_color = lv_color_hex(color.value);
-    lv_obj_set_style_text_color(obj, lv_color, LV_PART_MAIN);
-}
-
-void _lvSetWidth(lv_obj_t* obj, int width)
-{
-    lv_obj_set_width(obj, width);
-}
-
-void _lvSetHeight(lv_obj_t* obj, int height)
-{
-    lv_obj_set_height(obj, height);
-}
-
-void _lvSetBgColor(lv_obj_t* obj, lv_color_t color)
-{
-    lv_obj_set_style_bg_color(obj, color, LV_PART_MAIN);
-}
-
-void _lvSetBgColor(lv_obj_t* obj, const gui::style::Color& color)
-{
-    lv_color_t lv_color = lv_color_hex(color.value);
-    lv_obj_set_style_bg_color(obj, lv_color, LV_PART_MAIN);
-}
-
-// Progress Bar implementations
-lv_obj_t* _lvCreateProgressBar(lv_obj_t* parent, int value)
-{
-    lv_obj_t* bar = lv_bar_create(parent);
-    lv_bar_set_value(bar, value, LV_ANIM_ON);
-    return bar;
-}
-
-void _lvSetProgressValue(lv_obj_t* obj, int value)
-{
-    lv_bar_set_value(obj, value, LV_ANIM_ON);
-}
-
-void _lvSetProgressRange(lv_obj_t* obj, int min, int max)
-{
-    lv_bar_set_range(obj, min, max);
-}
-
-static void progress_event_cb(lv_event_t* e)
-{
-    auto* callback = static_cast<std::function<void(int)>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        lv_obj_t* obj = (lv_obj_t*)lv_event_get_target(e);
-        int value = lv_bar_get_value(obj);
-        (*callback)(value);
+    lv_img_header_t header;
+    if (file.size() <= sizeof(header)) {
+        return nullptr;
     }
-}
-
-void _lvSetProgressOnValueChanged(lv_obj_t* obj, std::function<void(int)> callback)
-{
-    auto* callback_ptr = new std::function<void(int)>(std::move(callback));
-    lv_obj_add_event_cb(obj, progress_event_cb, LV_EVENT_VALUE_CHANGED, callback_ptr);
-
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void(int)>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
-
-// Spinner implementations
-lv_obj_t* _lvCreateSpinner(lv_obj_t* parent)
-{
-    return lv_spinner_create(parent);
-}
-
-void _lvSetSpinnerTime(lv_obj_t* obj, uint32_t time)
-{
-    // Note: LVGL spinner doesn't have a direct API to set animation time
-    // We'll use the default animation time
-}
-
-void _lvSetSpinnerAngle(lv_obj_t* obj, uint16_t angle)
-{
-    // Note: LVGL spinner doesn't have a direct API to set angle
-    // We'll use the default angle
-}
-
-// Text Area implementations
-lv_obj_t* _lvCreateTextArea(lv_obj_t* parent, const char* placeholder)
-{
-    lv_obj_t* ta = lv_textarea_create(parent);
-    if (placeholder) {
-        lv_textarea_set_placeholder_text(ta, placeholder);
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.cf == LV_IMG_CF_UNKNOWN || header.cf == LV_IMG_CF_RAW || header.w == 0 || header.h == 0) {
+        return nullptr;
     }
-    return ta;
-}
-
-void _lvSetTextAreaText(lv_obj_t* obj, const char* text)
-{
-    lv_textarea_set_text(obj, text);
-}
-
-void _lvSetTextAreaPlaceholder(lv_obj_t* obj, const char* placeholder)
-{
-    lv_textarea_set_placeholder_text(obj, placeholder);
-}
-
-static void textarea_event_cb(lv_event_t* e)
-{
-    auto* callback = static_cast<std::function<void(const std::string&)>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        lv_obj_t* obj = (lv_obj_t*)lv_event_get_target(e);
-        const char* text = lv_textarea_get_text(obj);
-        (*callback)(std::string(text));
-    }
-}
-
-void _lvSetTextAreaOnTextChanged(lv_obj_t* obj, std::function<void(const std::string&)> callback)
-{
-    auto* callback_ptr = new std::function<void(const std::string&)>(std::move(callback));
-    lv_obj_add_event_cb(obj, textarea_event_cb, LV_EVENT_VALUE_CHANGED, callback_ptr);
-
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void(const std::string&)>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
-
-void _lvSetTextAreaMaxLength(lv_obj_t* obj, uint32_t max_len)
-{
-    lv_textarea_set_max_length(obj, max_len);
-}
-
-// List implementations
-lv_obj_t* _lvCreateList(lv_obj_t* parent)
-{
-    return lv_list_create(parent);
-}
-
-void _lvAddListItem(lv_obj_t* obj, const char* text)
-{
-    lv_list_add_text(obj, text);
-}
-
-static void list_event_cb(lv_event_t* e)
-{
-    auto* callback = static_cast<std::function<void(int, const std::string&)>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        lv_obj_t* obj = (lv_obj_t*)lv_event_get_target(e);
-        lv_obj_t* list_item = (lv_obj_t*)lv_event_get_target(e);
-        // Note: This is a simplified implementation. In a real scenario, you'd need to track item indices.
-        (*callback)(0, "List item clicked");
-    }
-}
-
-void _lvSetListOnItemSelected(lv_obj_t* obj, std::function<void(int, const std::string&)> callback)
-{
-    auto* callback_ptr = new std::function<void(int, const std::string&)>(std::move(callback));
-    lv_obj_add_event_cb(obj, list_event_cb, LV_EVENT_CLICKED, callback_ptr);
-
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void(int, const std::string&)>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
-
-// Bar implementations
-lv_obj_t* _lvCreateBar(lv_obj_t* parent, int value)
-{
-    lv_obj_t* bar = lv_bar_create(parent);
-    lv_bar_set_value(bar, value, LV_ANIM_ON);
-    return bar;
-}
-
-void _lvSetBarValue(lv_obj_t* obj, int value)
-{
-    lv_bar_set_value(obj, value, LV_ANIM_ON);
-}
-
-void _lvSetBarRange(lv_obj_t* obj, int min, int max)
-{
-    lv_bar_set_range(obj, min, max);
-}
-
-static void bar_event_cb(lv_event_t* e)
-{
-    auto* callback = static_cast<std::function<void(int)>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        lv_obj_t* obj = (lv_obj_t*)lv_event_get_target(e);
-        int value = lv_bar_get_value(obj);
-        (*callback)(value);
-    }
-}
-
-void _lvSetBarOnValueChanged(lv_obj_t* obj, std::function<void(int)> callback)
-{
-    auto* callback_ptr = new std::function<void(int)>(std::move(callback));
-    lv_obj_add_event_cb(obj, bar_event_cb, LV_EVENT_VALUE_CHANGED, callback_ptr);
-
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void(int)>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
-
-// --- Slider Implementation ---
-lv_obj_t* _lvCreateSlider(lv_obj_t* parent)
-{
-    return lv_slider_create(parent);
-}
-
-void _lvSetSliderRange(lv_obj_t* obj, int min, int max)
-{
-    lv_slider_set_range(obj, min, max);
-}
-
-void _lvSetSliderValue(lv_obj_t* obj, int value, bool anim)
-{
-    lv_slider_set_value(obj, value, anim ? LV_ANIM_ON : LV_ANIM_OFF);
-}
-
-static void slider_event_cb(lv_event_t* e)
-{
-    lv_obj_t* slider = (lv_obj_t*)lv_event_get_target(e);
-    auto* callback = static_cast<std::function<void(int)>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        int32_t value = lv_slider_get_value(slider);
-        (*callback)(value);
+    // Pixels plus the palette of the indexed formats and the alpha plane of the alpha-only ones, 0 for raw data
+    uint32_t size = lv_img_buf_get_img_size(header.w, header.h, header.cf);
+    if (size == 0 || file.size() - sizeof(header) < size) {
+        return nullptr;
     }
+    std::vector<uint8_t> pixels(file.begin() + sizeof(header), file.end());
+    return make_image(header.cf, header.w, header.h, std::move(pixels));
 }
 
-void _lvSetSliderOnValueChanged(lv_obj_t* obj, std::function<void(int)> callback)
-{
-    auto* callback_ptr = new std::function<void(int)>(std::move(callback));
-    lv_obj_add_event_cb(obj, slider_event_cb, LV_EVENT_VALUE_CHANGED, callback_ptr);
-
-    // Add a cleanup event to delete the callback
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void(int)>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
-
-// --- Switch Implementation ---
-lv_obj_t* _lvCreateSwitch(lv_obj_t* parent)
-{
-    return lv_switch_create(parent);
-}
-
-void _lvSetSwitchState(lv_obj_t* obj, bool isOn)
+std::shared_ptr<DecodedImage> decode_png(const std::vector<uint8_t>& file)
 {
-    if (isOn) {
-        lv_obj_add_state(obj, LV_STATE_CHECKED);
-    } else {
-        lv_obj_clear_state(obj, LV_STATE_CHECKED);
+#if LV_USE_PNG && LV_MEM_CUSTOM
+    unsigned char* rgba = nullptr;
+    unsigned w = 0;
+    unsigned h = 0;
+    if (lodepng_decode32(&rgba, &w, &h, file.data(), file.size()) != 0 || !rgba) {
+        return nullptr;
     }
-}
 
-static void switch_event_cb(lv_event_t* e)
-{
-    lv_obj_t* sw = (lv_obj_t*)lv_event_get_target(e);
-    auto* callback = static_cast<std::function<void(bool)>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        bool is_on = lv_obj_has_state(sw, LV_STATE_CHECKED);
-        (*callback)(is_on);
+    // LV_IMG_CF_TRUE_COLOR_ALPHA stores lv_color_t followed by the alpha byte
+    constexpr size_t kColorBytes = sizeof(lv_color_t);
+    std::vector<uint8_t> pixels(size_t(w) * h * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    uint8_t* out = pixels.data();
+    for (size_t i = 0; i < size_t(w) * h; ++i) {
+        const unsigned char* px = rgba + i * 4;
+        lv_color_t color = lv_color_make(px[0], px[1], px[2]);
+        std::memcpy(out, &color, kColorBytes);
+        out[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = px[3];
+        out += LV_IMG_PX_SIZE_ALPHA_BYTE;
     }
+    lv_mem_free(rgba);
+    return make_image(LV_IMG_CF_TRUE_COLOR_ALPHA, w, h, std::move(pixels));
+#else
+    (void)file;
+    return nullptr;
+#endif
 }
 
-void _lvSetSwitchOnToggle(lv_obj_t* obj, std::function<void(bool)> callback)
-{
-    auto* callback_ptr = new std::function<void(bool)>(std::move(callback));
-    lv_obj_add_event_cb(obj, switch_event_cb, LV_EVENT_VALUE_CHANGED, callback_ptr);
+// ==================== Asset packs ====================
+// tools/AssetPacker writes the LVGL 8 header and pixels, a pack is drawn in place on the build it was made for.
 
-    // Add a cleanup event to delete the callback
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void(bool)>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
+static constexpr uint32_t kPackFlags = LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP ? kAssetPackColor16Swap : 0;
 
-// --- Checkbox Implementation ---
-lv_obj_t* _lvCreateCheckbox(lv_obj_t* parent)
-{
-    return lv_checkbox_create(parent);
-}
+static_assert(sizeof(lv_img_header_t) == sizeof(uint32_t), "AssetPackEntry stores lv_img_header_t as uint32_t");
 
-void _lvSetCheckboxText(lv_obj_t* obj, const char* text)
+bool asset_pack_matches(const AssetPackHeader& header)
 {
-    lv_checkbox_set_text(obj, text);
-}
-
-void _lvSetCheckboxState(lv_obj_t* obj, bool isChecked)
-{
-    if (isChecked) {
-        lv_obj_add_state(obj, LV_STATE_CHECKED);
-    } else {
-        lv_obj_clear_state(obj, LV_STATE_CHECKED);
-    }
+    return header.colorDepth == LV_COLOR_DEPTH && header.flags == kPackFlags;
 }
 
-static void checkbox_event_cb(lv_event_t* e)
+bool describe_packed_image(const AssetPackHeader& header, const AssetPackEntry& entry, const uint8_t* base,
+                           image_dsc_t& dsc)
 {
-    lv_obj_t* cbx = (lv_obj_t*)lv_event_get_target(e);
-    auto* callback = static_cast<std::function<void(bool)>*>(lv_event_get_user_data(e));
-    if (callback && (*callback)) {
-        bool is_checked = lv_obj_has_state(cbx, LV_STATE_CHECKED);
-        (*callback)(is_checked);
+    (void)header;
+    std::memcpy(&dsc.header, &entry.imageHeader, sizeof(dsc.header));
+    // 0 for the formats that need a decoder
+    uint32_t needed = lv_img_buf_get_img_size(dsc.header.w, dsc.header.h, dsc.header.cf);
+    if (needed == 0 || entry.size < needed) {
+        return false;
     }
-}
-
-void _lvSetCheckboxOnToggle(lv_obj_t* obj, std::function<void(bool)> callback)
-{
-    auto* callback_ptr = new std::function<void(bool)>(std::move(callback));
-    lv_obj_add_event_cb(obj, checkbox_event_cb, LV_EVENT_VALUE_CHANGED, callback_ptr);
-
-    // Add a cleanup event to delete the callback
-    lv_obj_add_event_cb(obj, [](lv_event_t* e) {
-        auto* cb = static_cast<std::function<void(bool)>*>(lv_event_get_user_data(e));
-        delete cb;
-    }, LV_EVENT_DELETE, callback_ptr);
-}
-
-// --- Image Implementation ---
-lv_obj_t* _lvCreateImage(lv_obj_t* parent)
-{
-    return lv_img_create(parent);
-}
-
-void _lvSetImageSrc(lv_obj_t* obj, const lv_img_dsc_t* src)
-{
-    lv_img_set_src(obj, src);
+    dsc.data_size = entry.size;
+    dsc.data = base + entry.offset;
+    return true;
 }
 
 } // namespace adaptor
-} // namespace gui
\ No newline at end of file
+} // namespace gui
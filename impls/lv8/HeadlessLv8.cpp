@@ -0,0 +1,90 @@
+#include "../common/Headless.h"
+
+#include <lvgl.h>
+
+#include <cstring>
+
+#if LV_TICK_CUSTOM
+#warning "_lvStep advances the clock with lv_tick_inc, build LVGL with LV_TICK_CUSTOM 0 to step deterministically"
+#endif
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Headless display ====================
+// LVGL 8 draws lv_color_t rows without padding and registers the display through a driver.
+
+static void headless_flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* colors)
+{
+    auto* display = static_cast<HeadlessDisplay*>(drv->user_data);
+    headless_flush(*display, *area, reinterpret_cast<const uint8_t*>(colors), lv_disp_flush_is_last(drv));
+}
+
+static void headless_wait_cb(lv_disp_drv_t* drv)
+{
+    // Called by LVGL in a loop while the other buffer is still flushing, sleep instead of spinning
+    headless_wait_flushed(*static_cast<HeadlessDisplay*>(drv->user_data));
+}
+
+bool headless_register(HeadlessDisplay& display, uint32_t lines)
+{
+    const DisplayConfig& config = display.config;
+    size_t bufferPixels = static_cast<size_t>(config.width) * lines;
+    display.drawBuffers[0].resize(bufferPixels * sizeof(lv_color_t));
+    if (config.doubleBuffered) {
+        display.drawBuffers[1].resize(bufferPixels * sizeof(lv_color_t));
+    }
+
+    lv_disp_draw_buf_init(&display.drawBuf, display.drawBuffers[0].data(),
+                          config.doubleBuffered ? display.drawBuffers[1].data() : nullptr,
+                          static_cast<uint32_t>(bufferPixels));
+    lv_disp_drv_init(&display.driver);
+    display.driver.hor_res = static_cast<lv_coord_t>(config.width);
+    display.driver.ver_res = static_cast<lv_coord_t>(config.height);
+    display.driver.flush_cb = headless_flush_cb;
+    display.driver.draw_buf = &display.drawBuf;
+    display.driver.user_data = &display;
+    if (config.doubleBuffered) {
+        display.driver.wait_cb = headless_wait_cb;
+    }
+
+    display.disp = lv_disp_drv_register(&display.driver);
+    return display.disp != nullptr;
+}
+
+void headless_unregister(HeadlessDisplay& display)
+{
+    lv_disp_remove(display.disp);
+}
+
+void headless_flush_ready(HeadlessDisplay& display)
+{
+    lv_disp_flush_ready(&display.driver);
+}
+
+size_t headless_source_stride(const HeadlessDisplay& display, size_t width)
+{
+    (void)display;
+    return width * sizeof(lv_color_t);
+}
+
+void headless_convert_row(const HeadlessDisplay& display, const uint8_t* src, uint8_t* dst, size_t count)
+{
+#if LV_COLOR_DEPTH == 32
+    convert_argb8888_to_rgb565(reinterpret_cast<const uint32_t*>(src), reinterpret_cast<uint16_t*>(dst), count,
+                               display.conversion);
+#elif LV_COLOR_DEPTH == 16 && !LV_COLOR_16_SWAP
+    (void)display;
+    std::memcpy(dst, src, count * sizeof(lv_color_t));
+#else
+    (void)display;
+    const auto* colors = reinterpret_cast<const lv_color_t*>(src);
+    auto* out = reinterpret_cast<uint16_t*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = lv_color_to16(colors[i]);
+    }
+#endif
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,224 @@
+#include "../common/AdaptorCommon.h"
+
+#include <lvgl.h>
+#include <lvgl_private.h>
+
+#if LV_USE_LODEPNG && LV_USE_STDLIB_MALLOC != LV_STDLIB_BUILTIN
+#include <src/libs/lodepng/lodepng.h>
+#endif
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if LVGL_VERSION_MAJOR != 9
+#error "AdaptorLv9.cpp is the LVGL 9 backend, configure with GUI_LVGL_VERSION=8 for LVGL 8"
+#endif
+
+// The adaptor itself is in impls/common, this file holds what LVGL 9 does differently from LVGL 8 beyond the
+// calls LvCompat.h maps: the display events of the redraw profiler, the image formats and the translation of
+// the asset pack header.
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Redraw profiler ====================
+// LVGL 9 reports every invalidated area, every flushed area and the end of each refresh as events of the
+// display, so the profiler only listens to them.
+
+static lv_display_t* gRedrawDisplay = nullptr;
+
+static void redraw_display_cb(lv_event_t* e)
+{
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_INVALIDATE_AREA:
+            redraw_invalidated(static_cast<const lv_area_t*>(lv_event_get_param(e)));
+            break;
+        case LV_EVENT_FLUSH_START:
+            redraw_flushed(static_cast<const lv_area_t*>(lv_event_get_param(e)));
+            break;
+        case LV_EVENT_REFR_READY:
+            redraw_refreshed();
+            break;
+        default:
+            break;
+    }
+}
+
+void _lvEnableRedrawProfiler(bool isEnabled)
+{
+    if (isEnabled == (gRedrawDisplay != nullptr)) return;
+
+    if (isEnabled) {
+        lv_display_t* disp = lv_display_get_default();
+        if (!disp) return;
+
+        gRedrawDisplay = disp;
+        lv_display_add_event_cb(disp, redraw_display_cb, LV_EVENT_ALL, nullptr);
+    } else {
+        lv_display_remove_event_cb_with_user_data(gRedrawDisplay, redraw_display_cb, nullptr);
+        gRedrawDisplay = nullptr;
+    }
+}
+
+// ==================== Image decoding ====================
+// Supported files are LVGL 9's binary format (.bin, the header followed by the pixels) and PNG if LVGL is built
+// with LV_USE_LODEPNG and a thread-safe allocator (not LV_STDLIB_BUILTIN).
+
+static std::shared_ptr<DecodedImage> make_image(lv_color_format_t cf, uint32_t w, uint32_t h, uint32_t stride,
+                                               std::vector<uint8_t>&& data)
+{
+    auto image = std::make_shared<DecodedImage>();
+    image->data = std::move(data);
+    image->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    image->dsc.header.cf = cf;
+    image->dsc.header.w = w;
+    image->dsc.header.h = h;
+    image->dsc.header.stride = stride;
+    image->dsc.data_size = static_cast<uint32_t>(image->data.size());
+    image->dsc.data = image->data.data();
+    return image;
+}
+
+/**
+ * @brief Bytes a .bin image needs after the header: the palette of the indexed formats, the pixels and the
+ * alpha plane of RGB565A8
+ */
+static size_t image_data_size(lv_color_format_t cf, uint32_t h, uint32_t stride)
+{
+    size_t size = size_t(stride) * h;
+    if (LV_COLOR_FORMAT_IS_INDEXED(cf)) {
+        size += LV_COLOR_INDEXED_PALETTE_SIZE(cf) * sizeof(lv_color32_t);
+    } else if (cf == LV_COLOR_FORMAT_RGB565A8) {
+        size += size_t(stride / 2) * h;
+    }
+    return size;
+}
+
+std::shared_ptr<DecodedImage> decode_lvgl_bin(const std::vector<uint8_t>& file)
+{
+    lv_image_header_t header;
+    if (file.size() <= sizeof(header)) {
+        return nullptr;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    auto cf = static_cast<lv_color_format_t>(header.cf);
+    if (header.magic != LV_IMAGE_HEADER_MAGIC || cf == LV_COLOR_FORMAT_UNKNOWN || cf == LV_COLOR_FORMAT_RAW ||
+        cf == LV_COLOR_FORMAT_RAW_ALPHA || header.w == 0 || header.h == 0) {
+        return nullptr;
+    }
+    uint32_t stride = header.stride ? header.stride : lv_draw_buf_width_to_stride(header.w, cf);
+    if (file.size() - sizeof(header) < image_data_size(cf, header.h, stride)) {
+        return nullptr;
+    }
+    std::vector<uint8_t> pixels(file.begin() + sizeof(header), file.end());
+    return make_image(cf, header.w, header.h, stride, std::move(pixels));
+}
+
+std::shared_ptr<DecodedImage> decode_png(const std::vector<uint8_t>& file)
+{
+#if LV_USE_LODEPNG && LV_USE_STDLIB_MALLOC != LV_STDLIB_BUILTIN
+    unsigned char* rgba = nullptr;
+    unsigned w = 0;
+    unsigned h = 0;
+    if (lodepng_decode32(&rgba, &w, &h, file.data(), file.size()) != 0 || !rgba) {
+        return nullptr;
+    }
+
+    // LV_COLOR_FORMAT_ARGB8888 is stored as B, G, R, A whatever the display format
+    std::vector<uint8_t> pixels(size_t(w) * h * 4);
+    uint8_t* out = pixels.data();
+    for (size_t i = 0; i < size_t(w) * h; ++i) {
+        const unsigned char* px = rgba + i * 4;
+        out[0] = px[2];
+        out[1] = px[1];
+        out[2] = px[0];
+        out[3] = px[3];
+        out += 4;
+    }
+    lv_free(rgba);
+    return make_image(LV_COLOR_FORMAT_ARGB8888, w, h, w * 4, std::move(pixels));
+#else
+    (void)file;
+    return nullptr;
+#endif
+}
+
+// ==================== Asset packs ====================
+// tools/AssetPacker writes the LVGL 8 image header, it is translated to LVGL 9's when the pack is mapped. The
+// pixel layouts that LVGL 9 kept are drawn in place, an image in a layout it dropped (16 bit color with an
+// interleaved alpha byte, chroma keyed) is not found. LVGL 9 images are never byte swapped, packs made with
+// --swap for LV_COLOR_16_SWAP do not mount.
+
+// Color formats of the LVGL 8 header (lv_img_cf_t)
+enum : uint32_t {
+    kLv8TrueColor = 4,
+    kLv8TrueColorAlpha = 5,
+    kLv8Indexed1 = 7,
+    kLv8Indexed2 = 8,
+    kLv8Indexed4 = 9,
+    kLv8Indexed8 = 10,
+    kLv8Alpha8 = 14,
+};
+
+static lv_color_format_t lv8_color_format(uint32_t cf, uint32_t colorDepth)
+{
+    switch (cf) {
+        case kLv8TrueColor:
+            return colorDepth == 16 ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_XRGB8888;
+        case kLv8TrueColorAlpha:
+            return colorDepth == 32 ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_UNKNOWN;
+        case kLv8Indexed1:
+            return LV_COLOR_FORMAT_I1;
+        case kLv8Indexed2:
+            return LV_COLOR_FORMAT_I2;
+        case kLv8Indexed4:
+            return LV_COLOR_FORMAT_I4;
+        case kLv8Indexed8:
+            return LV_COLOR_FORMAT_I8;
+        case kLv8Alpha8:
+            return LV_COLOR_FORMAT_A8;
+        default:
+            return LV_COLOR_FORMAT_UNKNOWN;
+    }
+}
+
+static lv_image_header_t lv8_image_header(uint32_t packed, uint32_t colorDepth)
+{
+    // cf in bits 0-4, w in bits 10-20, h in bits 21-31
+    lv_image_header_t header{};
+    header.magic = LV_IMAGE_HEADER_MAGIC;
+    header.cf = lv8_color_format(packed & 0x1F, colorDepth);
+    header.w = (packed >> 10) & 0x7FF;
+    header.h = packed >> 21;
+    if (header.cf != LV_COLOR_FORMAT_UNKNOWN) {
+        // LVGL 8 rows are packed without padding, like LVGL 9's default stride
+        header.stride = lv_draw_buf_width_to_stride(header.w, static_cast<lv_color_format_t>(header.cf));
+    }
+    return header;
+}
+
+bool asset_pack_matches(const AssetPackHeader& header)
+{
+    return (header.colorDepth == 16 || header.colorDepth == 32) && header.flags == 0;
+}
+
+bool describe_packed_image(const AssetPackHeader& header, const AssetPackEntry& entry, const uint8_t* base,
+                           image_dsc_t& dsc)
+{
+    dsc.header = lv8_image_header(entry.imageHeader, header.colorDepth);
+    auto cf = static_cast<lv_color_format_t>(dsc.header.cf);
+    if (cf == LV_COLOR_FORMAT_UNKNOWN) {
+        // Kept without data, the pack still serves its other images
+        return true;
+    }
+    if (entry.size < image_data_size(cf, dsc.header.h, dsc.header.stride)) {
+        return false;
+    }
+    dsc.data_size = entry.size;
+    dsc.data = base + entry.offset;
+    return true;
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,88 @@
+#include "../common/Headless.h"
+
+#include <lvgl.h>
+
+#include <cstring>
+
+namespace gui {
+namespace adaptor {
+
+// ==================== Headless display ====================
+// LVGL 9 draws in the display's color format, with rows padded to the stride alignment of the build.
+
+static void headless_flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* pixels)
+{
+    auto* display = static_cast<HeadlessDisplay*>(lv_display_get_user_data(disp));
+    headless_flush(*display, *area, pixels, lv_display_flush_is_last(disp));
+}
+
+static void headless_wait_cb(lv_display_t* disp)
+{
+    // Called by LVGL while the other buffer is still flushing, it has to return once the flush is done
+    headless_wait_flushed(*static_cast<HeadlessDisplay*>(lv_display_get_user_data(disp)));
+}
+
+bool headless_register(HeadlessDisplay& display, uint32_t lines)
+{
+    const DisplayConfig& config = display.config;
+    display.disp = lv_display_create(config.width, config.height);
+    if (!display.disp) {
+        return false;
+    }
+    // LVGL 9 sizes the draw buffers in bytes and wants them aligned to LV_DRAW_BUF_ALIGN
+    lv_color_format_t cf = lv_display_get_color_format(display.disp);
+    size_t bufferBytes = size_t(lv_draw_buf_width_to_stride(static_cast<uint32_t>(config.width), cf)) * lines;
+    display.drawBuffers[0].resize(bufferBytes + LV_DRAW_BUF_ALIGN);
+    if (config.doubleBuffered) {
+        display.drawBuffers[1].resize(bufferBytes + LV_DRAW_BUF_ALIGN);
+    }
+
+    lv_display_set_buffers(display.disp, lv_draw_buf_align(display.drawBuffers[0].data(), cf),
+                           config.doubleBuffered ? lv_draw_buf_align(display.drawBuffers[1].data(), cf) : nullptr,
+                           static_cast<uint32_t>(bufferBytes), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_user_data(display.disp, &display);
+    lv_display_set_flush_cb(display.disp, headless_flush_cb);
+    if (config.doubleBuffered) {
+        lv_display_set_flush_wait_cb(display.disp, headless_wait_cb);
+    }
+    return true;
+}
+
+void headless_unregister(HeadlessDisplay& display)
+{
+    lv_display_delete(display.disp);
+}
+
+void headless_flush_ready(HeadlessDisplay& display)
+{
+    lv_display_flush_ready(display.disp);
+}
+
+size_t headless_source_stride(const HeadlessDisplay& display, size_t width)
+{
+    lv_color_format_t cf = lv_display_get_color_format(display.disp);
+    return lv_draw_buf_width_to_stride(static_cast<uint32_t>(width), cf);
+}
+
+void headless_convert_row(const HeadlessDisplay& display, const uint8_t* src, uint8_t* dst, size_t count)
+{
+#if LV_COLOR_DEPTH == 32
+    // XRGB8888 is 0xXXRRGGBB read as uint32_t, like the 32 bit lv_color_t of LVGL 8
+    convert_argb8888_to_rgb565(reinterpret_cast<const uint32_t*>(src), reinterpret_cast<uint16_t*>(dst), count,
+                               display.conversion);
+#elif LV_COLOR_DEPTH == 16
+    (void)display;
+    std::memcpy(dst, src, count * sizeof(uint16_t));
+#else
+    // RGB888, stored as B, G, R
+    (void)display;
+    auto* out = reinterpret_cast<uint16_t*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* px = src + i * 3;
+        out[i] = static_cast<uint16_t>(((px[2] & 0xF8) << 8) | ((px[1] & 0xFC) << 3) | (px[0] >> 3));
+    }
+#endif
+}
+
+} // namespace adaptor
+} // namespace gui
@@ -0,0 +1,174 @@
+// Packs LVGL binary images (.bin, as written by LVGL's image converter) into one asset pack, see gui/AssetPack.h
+//
+//   asset_packer --depth <16|32> [--swap] -o <out.pack> <image.bin>...
+//
+// Every image is stored under the path given on the command line, the Image view looks it up by that name.
+// --swap marks 16 bit images converted for LV_COLOR_16_SWAP, a pack only mounts on a build with the same setting.
+
+#include "gui/AssetPack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Input
+{
+    std::string name;
+    uint32_t imageHeader = 0;
+    std::vector<uint8_t> data;
+};
+
+bool read_image(const std::string& path, Input& input)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::fprintf(stderr, "asset_packer: cannot open %s\n", path.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> content;
+    uint8_t buffer[64 * 1024];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.insert(content.end(), buffer, buffer + n);
+    }
+    std::fclose(file);
+
+    uint32_t header = 0;
+    if (content.size() <= sizeof(header)) {
+        std::fprintf(stderr, "asset_packer: %s is not an LVGL image\n", path.c_str());
+        return false;
+    }
+    std::memcpy(&header, content.data(), sizeof(header));
+    // lv_img_header_t: cf in bits 0-4, 0 is LV_IMG_CF_UNKNOWN and 1-3 are the LV_IMG_CF_RAW* formats (need a decoder)
+    uint32_t cf = header & 0x1F;
+    if (cf <= 3 || (header >> 10) == 0) {
+        std::fprintf(stderr, "asset_packer: %s is not a decoded LVGL image\n", path.c_str());
+        return false;
+    }
+
+    input.name = path;
+    input.imageHeader = header;
+    input.data.assign(content.begin() + sizeof(header), content.end());
+    return true;
+}
+
+uint64_t align_up(uint64_t value)
+{
+    return (value + gui::kAssetPackAlignment - 1) / gui::kAssetPackAlignment * gui::kAssetPackAlignment;
+}
+
+bool write_pack(const char* path, uint32_t colorDepth, uint32_t flags, const std::vector<Input>& inputs)
+{
+    gui::AssetPackHeader header{gui::kAssetPackMagic, gui::kAssetPackVersion, static_cast<uint32_t>(inputs.size()),
+                                colorDepth, flags};
+    std::vector<gui::AssetPackEntry> entries(inputs.size());
+
+    uint64_t offset = align_up(sizeof(header) + entries.size() * sizeof(gui::AssetPackEntry));
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        gui::AssetPackEntry& entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.name, inputs[i].name.c_str(), inputs[i].name.size() + 1);
+        entry.imageHeader = inputs[i].imageHeader;
+        entry.offset = static_cast<uint32_t>(offset);
+        entry.size = static_cast<uint32_t>(inputs[i].data.size());
+        offset = align_up(offset + entry.size);
+        if (offset > UINT32_MAX) {
+            std::fprintf(stderr, "asset_packer: pack exceeds 4 GiB\n");
+            return false;
+        }
+    }
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::fprintf(stderr, "asset_packer: cannot create %s\n", path);
+        return false;
+    }
+
+    static const uint8_t kPadding[gui::kAssetPackAlignment] = {};
+    uint64_t written = 0;
+    auto write = [&](const void* data, size_t size) {
+        if (size && std::fwrite(data, 1, size, file) != size) {
+            return false;
+        }
+        written += size;
+        return true;
+    };
+    auto pad = [&]() { return write(kPadding, static_cast<size_t>(align_up(written) - written)); };
+
+    bool ok = write(&header, sizeof(header)) && write(entries.data(), entries.size() * sizeof(entries[0])) && pad();
+    for (size_t i = 0; ok && i < inputs.size(); ++i) {
+        ok = write(inputs[i].data.data(), inputs[i].data.size()) && pad();
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::fprintf(stderr, "asset_packer: failed to write %s\n", path);
+    }
+    return ok;
+}
+
+int usage()
+{
+    std::fprintf(stderr, "usage: asset_packer --depth <16|32> [--swap] -o <out.pack> <image.bin>...\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* output = nullptr;
+    uint32_t colorDepth = 0;
+    uint32_t flags = 0;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            colorDepth = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--swap") == 0) {
+            flags |= gui::kAssetPackColor16Swap;
+        } else if (argv[i][0] == '-') {
+            return usage();
+        } else {
+            paths.emplace_back(argv[i]);
+        }
+    }
+    // 1 and 8 bit builds would need the palette handling of LVGL, they are not worth packing
+    if (!output || paths.empty() || (colorDepth != 16 && colorDepth != 32) ||
+        ((flags & gui::kAssetPackColor16Swap) && colorDepth != 16)) {
+        return usage();
+    }
+
+    std::vector<Input> inputs(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (paths[i].size() >= gui::kAssetNameSize) {
+            std::fprintf(stderr, "asset_packer: name too long (max %zu): %s\n", gui::kAssetNameSize - 1,
+                         paths[i].c_str());
+            return 1;
+        }
+        if (!read_image(paths[i], inputs[i])) {
+            return 1;
+        }
+    }
+
+    // The loader looks names up with a binary search
+    std::sort(inputs.begin(), inputs.end(), [](const Input& a, const Input& b) { return a.name < b.name; });
+    for (size_t i = 1; i < inputs.size(); ++i) {
+        if (inputs[i].name == inputs[i - 1].name) {
+            std::fprintf(stderr, "asset_packer: duplicate image %s\n", inputs[i].name.c_str());
+            return 1;
+        }
+    }
+
+    if (!write_pack(output, colorDepth, flags, inputs)) {
+        return 1;
+    }
+    std::printf("asset_packer: %zu images written to %s\n", inputs.size(), output);
+    return 0;
+}
@@ -0,0 +1,360 @@
+// Headless benchmarks of the view layer, driven by _lvStep so the numbers do not depend on a panel
+//
+//   gui_bench [scenario...]
+//
+// Runs every scenario if none is given. Build it with -DGUI_BUILD_BENCH=ON in each configuration to compare
+// (e.g. GUI_LVGL_VERSION 8 and 9, GUI_ENABLE_LTO OFF and ON), the LVGL build uses the lv_conf.h of the project.
+
+#include "gui/Render.h"
+#include "gui/components/Button.h"
+#include "gui/components/Container.h"
+#include "gui/components/Label.h"
+
+#include <lvgl.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using namespace gui;
+
+constexpr uint32_t kFrameMs = 16;
+
+uint64_t elapsed_us(Clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+lv_obj_t* screen()
+{
+#if LVGL_VERSION_MAJOR >= 9
+    return lv_screen_active();
+#else
+    return lv_scr_act();
+#endif
+}
+
+/**
+ * @brief Time of the frame that renders what the scenario just built
+ */
+uint64_t first_frame_us()
+{
+    auto start = Clock::now();
+    adaptor::_lvStep(kFrameMs);
+    return elapsed_us(start);
+}
+
+/**
+ * @brief Invalidated areas the redraw profiler saw since the last reset, over all tags
+ */
+uint64_t invalidations()
+{
+    uint64_t count = 0;
+    for (const auto& stat : adaptor::_lvGetRedrawReport(SIZE_MAX).top) {
+        count += stat.invalidations;
+    }
+    return count;
+}
+
+struct MemoryUse
+{
+    size_t lvgl = 0;    ///< LVGL's own heap, 0 if LVGL allocates through malloc
+    size_t heap = 0;    ///< malloc heap, i.e. the views and the adaptor tables
+};
+
+MemoryUse memory_use()
+{
+    MemoryUse use;
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor);
+    use.lvgl = monitor.total_size - monitor.free_size;
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+    use.heap = mallinfo2().uordblks;
+#endif
+    return use;
+}
+
+size_t kib(size_t after, size_t before)
+{
+    return after > before ? (after - before) / 1024 : 0;
+}
+
+void clear_screen()
+{
+    lv_obj_clean(screen());
+    adaptor::_lvStep(kFrameMs);
+    adaptor::_lvResetRedrawProfiler();
+}
+
+// ==================== Stack layout ====================
+// Rows of labels in HStacks with spacing, alignment and padding. The views share one flex style per
+// configuration, the per-call variant sets the same properties one lv_obj_set_* at a time.
+
+constexpr int kStackRows = 200;
+
+void stacks_views()
+{
+    auto start = Clock::now();
+    VStack root;
+    for (int i = 0; i < kStackRows; ++i) {
+        root.addChild(HStack(Label("name"), Label("value"), Label("unit"))
+                          .spacing(4)
+                          .alignment(style::Layout::Vertical::Center)
+                          .padding(2));
+    }
+    root.create(screen());
+    uint64_t buildUs = elapsed_us(start);
+    uint64_t count = invalidations();
+
+    std::printf("  views     build %8llu us  layout %6llu us  invalidations %6llu  first frame %6llu us\n",
+                static_cast<unsigned long long>(buildUs),
+                static_cast<unsigned long long>(adaptor::_lvGetBuildStats().lastLayoutUs),
+                static_cast<unsigned long long>(count), static_cast<unsigned long long>(first_frame_us()));
+}
+
+void stacks_per_call()
+{
+    auto start = Clock::now();
+    adaptor::_lvSetRedrawTag("per-call");
+    lv_obj_t* root = lv_obj_create(screen());
+    lv_obj_set_size(root, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_layout(root, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(root, LV_FLEX_FLOW_COLUMN);
+    for (int i = 0; i < kStackRows; ++i) {
+        lv_obj_t* row = lv_obj_create(root);
+        lv_obj_set_size(row, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        lv_obj_set_layout(row, LV_LAYOUT_FLEX);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+        lv_obj_set_style_pad_column(row, 4, LV_PART_MAIN);
+        lv_obj_set_flex_align(row, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+        lv_obj_set_style_pad_all(row, 2, LV_PART_MAIN);
+        for (const char* text : {"name", "value", "unit"}) {
+            lv_label_set_text(lv_label_create(row), text);
+        }
+    }
+    auto layoutStart = Clock::now();
+    lv_obj_update_layout(root);
+    uint64_t layoutUs = elapsed_us(layoutStart);
+    adaptor::_lvSetRedrawTag(nullptr);
+    uint64_t buildUs = elapsed_us(start);
+    uint64_t count = invalidations();
+
+    std::printf("  per-call  build %8llu us  layout %6llu us  invalidations %6llu  first frame %6llu us\n",
+                static_cast<unsigned long long>(buildUs), static_cast<unsigned long long>(layoutUs),
+                static_cast<unsigned long long>(count), static_cast<unsigned long long>(first_frame_us()));
+}
+
+void bench_stacks()
+{
+    std::printf("stacks: %d HStacks of 3 labels\n", kStackRows);
+    stacks_views();
+    clear_screen();
+    stacks_per_call();
+    clear_screen();
+}
+
+// ==================== Delegated events ====================
+// A list of interactive rows, each Button registering its own click handler or the container handling
+// the clicks of all rows. The views are kept alive until the memory is measured.
+
+constexpr int kInteractiveRows = 1000;
+
+void interactive_rows(const char* name, bool delegated)
+{
+    MemoryUse before = memory_use();
+    auto start = Clock::now();
+    int clicks = 0;
+    VStack root;
+    if (delegated) {
+        root.onChildClick([&clicks](ViewBase&, size_t) { ++clicks; });
+    }
+    for (int i = 0; i < kInteractiveRows; ++i) {
+        Button row("row");
+        if (!delegated) {
+            row.onClick([&clicks] { ++clicks; });
+        }
+        root.addChild(std::move(row));
+    }
+    root.create(screen());
+    uint64_t buildUs = elapsed_us(start);
+    MemoryUse after = memory_use();
+
+    std::printf("  %-9s build %8llu us  LVGL heap +%5zu KiB  malloc heap +%5zu KiB  first frame %6llu us\n", name,
+                static_cast<unsigned long long>(buildUs), kib(after.lvgl, before.lvgl), kib(after.heap, before.heap),
+                static_cast<unsigned long long>(first_frame_us()));
+}
+
+void bench_delegation()
+{
+    std::printf("delegation: %d buttons in a VStack\n", kInteractiveRows);
+    interactive_rows("per-row", false);
+    clear_screen();
+    interactive_rows("delegated", true);
+    clear_screen();
+}
+
+// ==================== List insertion ====================
+// A list filled with all rows in one _lvAddListItems call or with one call per row, as a caller adding
+// the items one at a time would.
+
+constexpr size_t kListItems = 10000;
+
+void list_items(const char* name, bool bulk)
+{
+    std::vector<std::string> texts;
+    texts.reserve(kListItems);
+    for (size_t i = 0; i < kListItems; ++i) {
+        texts.push_back("item " + std::to_string(i));
+    }
+    std::vector<const char*> rows;
+    rows.reserve(kListItems);
+    for (const auto& text : texts) {
+        rows.push_back(text.c_str());
+    }
+
+    MemoryUse before = memory_use();
+    auto start = Clock::now();
+    lv_obj_t* list = adaptor::_lvCreateList(screen());
+    if (bulk) {
+        adaptor::_lvAddListItems(list, rows.data(), rows.size());
+    } else {
+        for (const char* row : rows) {
+            adaptor::_lvAddListItems(list, &row, 1);
+        }
+    }
+    uint64_t buildUs = elapsed_us(start);
+    uint64_t count = invalidations();
+    MemoryUse after = memory_use();
+
+    std::printf("  %-9s build %8llu us  invalidations %6llu  LVGL heap +%5zu KiB  first frame %6llu us\n", name,
+                static_cast<unsigned long long>(buildUs), static_cast<unsigned long long>(count),
+                kib(after.lvgl, before.lvgl), static_cast<unsigned long long>(first_frame_us()));
+}
+
+void bench_list()
+{
+    std::printf("list: %zu items\n", kListItems);
+    list_items("bulk", true);
+    clear_screen();
+    list_items("per-item", false);
+    clear_screen();
+}
+
+// ==================== Build time ====================
+// The same screen of styled rows built and cleared repeatedly, timed by the build scope. This is the number
+// GUI_ENABLE_LTO is meant to move: run it in a build with LTO OFF and one with ON.
+
+constexpr int kBuildRows = 100;
+constexpr int kBuildRounds = 20;
+
+void build_screen()
+{
+    VStack root;
+    for (int i = 0; i < kBuildRows; ++i) {
+        root.addChild(HStack(Label("name").foregroundColor(style::ColorToken::TextPrimary),
+                             Label("value").font(style::FontToken::Body),
+                             Button("edit").padding(style::SpacingToken::Small))
+                          .spacing(4)
+                          .backgroundColor(style::ColorToken::BgTop)
+                          .cornerRadius(style::RadiusToken::Small));
+    }
+    root.create(screen());
+}
+
+void bench_build()
+{
+    std::printf("build: %d rows of 2 labels and a button, %d rounds\n", kBuildRows, kBuildRounds);
+    adaptor::BuildStats before = adaptor::_lvGetBuildStats();
+    uint64_t layoutUs = 0;
+    uint64_t minBuildUs = UINT64_MAX;
+    for (int round = 0; round < kBuildRounds; ++round) {
+        build_screen();
+        adaptor::BuildStats stats = adaptor::_lvGetBuildStats();
+        layoutUs += stats.lastLayoutUs;
+        minBuildUs = std::min(minBuildUs, stats.lastBuildUs);
+        clear_screen();
+    }
+    adaptor::BuildStats after = adaptor::_lvGetBuildStats();
+    uint32_t builds = after.builds - before.builds;
+    uint64_t totalUs = after.totalBuildUs - before.totalBuildUs;
+
+    std::printf("  build     avg %8llu us  min %8llu us  layout avg %8llu us  (%u builds)\n",
+                static_cast<unsigned long long>(builds ? totalUs / builds : 0),
+                static_cast<unsigned long long>(minBuildUs),
+                static_cast<unsigned long long>(kBuildRounds ? layoutUs / kBuildRounds : 0), builds);
+}
+
+struct Scenario
+{
+    const char* name;
+    void (*run)();
+};
+
+constexpr Scenario kScenarios[] = {
+    {"stacks", bench_stacks},
+    {"delegation", bench_delegation},
+    {"list", bench_list},
+    {"build", bench_build},
+};
+
+int usage()
+{
+    std::fprintf(stderr, "usage: gui_bench [scenario...]\nscenarios:");
+    for (const auto& scenario : kScenarios) {
+        std::fprintf(stderr, " %s", scenario.name);
+    }
+    std::fprintf(stderr, "\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        bool known = false;
+        for (const auto& scenario : kScenarios) {
+            known = known || std::strcmp(argv[i], scenario.name) == 0;
+        }
+        if (!known) {
+            return usage();
+        }
+    }
+
+    if (Render::instance().init() != 0 || adaptor::_lvCreateHeadlessDisplay(adaptor::DisplayConfig{}) != 0) {
+        std::fprintf(stderr, "gui_bench: cannot create the headless display\n");
+        return 1;
+    }
+    adaptor::_lvEnableRedrawProfiler(true);
+    adaptor::_lvStep(kFrameMs);
+    adaptor::_lvResetRedrawProfiler();
+
+    // The configuration that decides the numbers, so the outputs of two builds can be put side by side
+    std::printf("LVGL %d.%d.%d, %d bit color", LVGL_VERSION_MAJOR, LVGL_VERSION_MINOR, LVGL_VERSION_PATCH,
+                LV_COLOR_DEPTH);
+#if LVGL_VERSION_MAJOR >= 9 && defined(LV_DRAW_SW_DRAW_UNIT_CNT)
+    std::printf(", %d software draw units", LV_DRAW_SW_DRAW_UNIT_CNT);
+#endif
+    std::printf("\n");
+    for (const auto& scenario : kScenarios) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i) {
+            selected = selected || std::strcmp(argv[i], scenario.name) == 0;
+        }
+        if (selected) {
+            scenario.run();
+        }
+    }
+
+    adaptor::_lvDestroyHeadlessDisplay();
+    return 0;
+}